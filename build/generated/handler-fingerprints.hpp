@@ -0,0 +1,87 @@
+// Generated by scripts/handler-fingerprints.sh, do not edit
+#ifndef _HANDLER_FINGERPRINTS_HPP_
+#define _HANDLER_FINGERPRINTS_HPP_
+#include <cstdint>
+#include <string_view>
+
+#define MOS6502_BUILD_FLAGS "g++ -std=c++20 -g"
+#define MOS6502_CORE_FINGERPRINT 2214913061u
+
+struct HandlerFingerprint {
+    std::string_view name;
+    uint32_t fingerprint;
+};
+
+static constexpr HandlerFingerprint handler_fingerprints[] = {
+    {"ADC", 3201239636u},
+    {"AND", 3324463539u},
+    {"ASL", 1673169560u},
+    {"BCC", 1692379791u},
+    {"BCS", 728265076u},
+    {"BEQ", 2779965348u},
+    {"BIT", 2823739605u},
+    {"BMI", 2111774396u},
+    {"BNE", 3927974369u},
+    {"BPL", 2380333579u},
+    {"BRK", 2156637665u},
+    {"BVC", 1602818450u},
+    {"BVS", 2326909835u},
+    {"CLC", 1394685663u},
+    {"CLD", 1450903356u},
+    {"CLI", 2796921669u},
+    {"CLV", 593429593u},
+    {"CMP", 3054610439u},
+    {"CPX", 116973161u},
+    {"CPY", 4247126011u},
+    {"DEC", 1448640937u},
+    {"DEX", 3330182008u},
+    {"DEY", 680379035u},
+    {"EOR", 2038780741u},
+    {"INC", 2339387922u},
+    {"INX", 466714420u},
+    {"INY", 4112660183u},
+    {"JMP", 2477140974u},
+    {"JSR", 370343202u},
+    {"LDA", 780811510u},
+    {"LDX", 1456935114u},
+    {"LDY", 178033404u},
+    {"LSR", 3049278177u},
+    {"NOP", 3225085046u},
+    {"ORA", 2268538577u},
+    {"PHA", 249121592u},
+    {"PHP", 914801858u},
+    {"PLA", 2561072932u},
+    {"PLP", 434235915u},
+    {"ROL", 707613837u},
+    {"ROR", 3125344572u},
+    {"RTI", 1993989494u},
+    {"RTS", 3914438219u},
+    {"SBC", 4190414884u},
+    {"SEC", 1186760289u},
+    {"SED", 601590509u},
+    {"SEI", 3942539807u},
+    {"STA", 58250417u},
+    {"STX", 137817236u},
+    {"STY", 598460634u},
+    {"TAX", 2173296609u},
+    {"TAY", 3678062976u},
+    {"TSX", 17278394u},
+    {"TXA", 1912525431u},
+    {"TXS", 4199645671u},
+    {"TYA", 21573149u},
+    {"XXX", 818629740u},
+    {"IMP", 4204298666u},
+    {"IMM", 3550012681u},
+    {"ZP0", 1607608984u},
+    {"ZPX", 807409994u},
+    {"ZPY", 3370554133u},
+    {"REL", 2336457319u},
+    {"ABS", 3492881997u},
+    {"ABX", 996016066u},
+    {"ABY", 2891403280u},
+    {"IND", 3422318705u},
+    {"IZX", 3472410397u},
+    {"IZY", 718617986u},
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef _BENCHMARK_COMPARISON_HPP_
+#define _BENCHMARK_COMPARISON_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+// External Library Includes
+#include <nlohmann/json.hpp>
+// Using shorthand declarations
+using json = nlohmann::json;
+
+struct WelchTest {
+    double t_statistic;
+    double degrees_of_freedom;
+    // Two-sided, probability of a difference at least this large if the means were equal
+    double p_value;
+};
+
+/**
+* @brief  Runs Welch's unequal variances t-test on two samples
+* @param  baseline: First sample
+* @param  candidate: Second sample
+* @return t statistic, Welch-Satterthwaite degrees of freedom and two-sided p-value
+*/
+WelchTest welchTTest(const std::vector<double>& baseline, const std::vector<double>& candidate);
+
+// Compares two result files written by benchmark --json, workload by workload
+class BenchmarkComparison {
+public:
+    enum class Verdict {
+        UNCHANGED,
+        IMPROVED,
+        REGRESSED,
+        MISSING,
+    };
+
+    struct WorkloadComparison {
+        std::string name;
+        // Host nanoseconds per emulated instruction, mean over repetitions
+        double baseline_ns;
+        double candidate_ns;
+        // Positive when the candidate is slower
+        double delta_percent;
+        WelchTest test;
+        Verdict verdict;
+    };
+
+    /**
+    * @brief  Constructor for BenchmarkComparison
+    * @param  baseline: Parsed baseline result file
+    * @param  candidate: Parsed candidate result file
+    * @param  threshold_percent: Smallest slowdown or speedup that counts as a change
+    * @param  alpha: Significance level of the t-test
+    * @return None
+    */
+    BenchmarkComparison(const json& baseline, const json& candidate, const double& threshold_percent, const double& alpha);
+
+    /**
+    * @brief  Checks whether any workload regressed
+    * @param  None
+    * @return True if a workload is significantly slower by more than the threshold
+    */
+    bool hasRegression() const;
+
+    /**
+    * @brief  Writes the metadata that differs between the files and one row per workload
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeReport(std::ostream& out) const;
+
+private:
+    const json baseline_metadata_;
+    const json candidate_metadata_;
+    const double threshold_percent_;
+    const double alpha_;
+    std::vector<WorkloadComparison> comparisons_;
+};
+
+#endif
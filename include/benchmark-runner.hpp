@@ -0,0 +1,183 @@
+#ifndef _BENCHMARK_RUNNER_HPP_
+#define _BENCHMARK_RUNNER_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <cstdint>
+// External Library Includes
+#include <nlohmann/json.hpp>
+// Project Includes
+#include "benchmark-workloads.hpp"
+// Using shorthand declarations
+using json = nlohmann::json;
+
+struct BenchmarkOptions {
+    // Instructions executed by every timed repetition
+    uint64_t instructions = 5000000;
+    // Untimed repetitions run first to warm caches and branch predictors
+    uint32_t warmup_repetitions = 1;
+    uint32_t repetitions = 5;
+    // Read host performance counters around every timed repetition
+    bool hardware_counters = false;
+};
+
+// How the instances of a scaling run hold their program
+enum class MemoryLayout {
+    // Every instance has its own copy of the whole 64kB image
+    PRIVATE_RAM,
+    // Every instance has its own RAM, but the program is read from one image mapped as ROM on every BUS
+    SHARED_ROM,
+};
+
+struct BenchmarkResult {
+    std::string name;
+    // Per repetition, identical across repetitions since workloads are deterministic
+    uint64_t instructions;
+    uint64_t cycles;
+    // Host seconds of every timed repetition
+    std::vector<double> seconds;
+    // Host performance counters summed over the timed repetitions, keyed by PerfCounters::counter_names
+    //   Counters the host does not provide are absent
+    std::map<std::string, uint64_t> counters;
+    // Why counters are missing, empty if every counter was read
+    std::string counters_unavailable;
+    // Threads and instances per thread of runScaling, instructions and cycles are totals over all instances
+    uint32_t threads = 1;
+    uint32_t instances_per_thread = 1;
+
+    /**
+    * @brief  Gets the median host time of the timed repetitions
+    * @param  None
+    * @return Median seconds per repetition
+    */
+    double medianSeconds() const;
+};
+
+// Times workloads on a fresh CPU, RAM and BUS per repetition
+class BenchmarkRunner {
+public:
+    /**
+    * @brief  Constructor for BenchmarkRunner
+    * @param  options: Instruction count, warmup and repetitions
+    * @return None
+    */
+    BenchmarkRunner(const BenchmarkOptions& options);
+
+    /**
+    * @brief  Runs the warmup and timed repetitions of a workload
+    * @param  workload: The workload to time
+    * @return Instructions, cycles and host time of every repetition
+    */
+    BenchmarkResult run(const BenchmarkWorkload& workload) const;
+
+    /**
+    * @brief  Runs instances_per_thread instances of a workload on each of threads threads, every instance on its own
+    *         CPU, RAM and BUS created by the thread that runs it, interleaved in slices of instructions
+    *         Every instance runs the option's instruction count, the seconds are the wall time until all finished
+    * @param  workload: The workload to run
+    * @param  threads: Number of threads
+    * @param  instances_per_thread: Number of instances each thread runs
+    * @param  layout: Whether instances share the program as ROM
+    * @return Total instructions and cycles of all instances and the wall time of every repetition
+    */
+    BenchmarkResult runScaling(const BenchmarkWorkload& workload, const uint32_t& threads, const uint32_t& instances_per_thread, const MemoryLayout& layout) const;
+
+    /**
+    * @brief  Times creating a CPU, RAM and BUS from an image and running the first instruction, once per repetition
+    * @param  image: Memory image copied into every new machine
+    * @return One result whose seconds are the latency of every repetition
+    */
+    BenchmarkResult measureStartup(const MemoryUnit& image) const;
+
+    /**
+    * @brief  Times spawning a process that creates a machine, runs its first instruction and exits, once per repetition
+    * @param  executable: Program to spawn
+    * @param  arguments: Arguments that make it do only that
+    * @return One result whose seconds are the latency of every repetition
+    */
+    BenchmarkResult measureProcessStartup(const std::string& executable, const std::vector<std::string>& arguments) const;
+
+    /**
+    * @brief  Creates a machine and runs its first instruction, the work timed by measureStartup
+    * @param  image: Memory image copied into the machine
+    * @return Cycles of the first instruction
+    */
+    static uint64_t startMachine(const MemoryUnit& image);
+
+    /**
+    * @brief  Writes p50/p90/p99 and mean latency in microseconds per result
+    * @param  out: The output stream
+    * @param  results: Results of measureStartup and measureProcessStartup
+    * @return None
+    */
+    static void writeLatencyReport(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    /**
+    * @brief  Writes instructions/s, emulated cycles/s and speed relative to MOS6502_CLOCK_SPEED per result
+    * @param  out: The output stream
+    * @param  results: The results to report
+    * @return None
+    */
+    static void writeReport(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    /**
+    * @brief  Writes aggregate instructions/s, instructions/s per thread and the efficiency relative to
+    *         the single thread result of the same workload, layout and instances per thread
+    * @param  out: The output stream
+    * @param  results: Results of runScaling
+    * @return None
+    */
+    static void writeScalingReport(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    /**
+    * @brief  Writes host nanoseconds and emulated cycles per instruction for microbenchmark results,
+    *         followed by the mean cost of every addressing mode
+    * @param  out: The output stream
+    * @param  results: Results of microbenchmarkWorkloads()
+    * @return None
+    */
+    static void writeCostReport(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    /**
+    * @brief  Writes host cycles, instructions, branch misses and L1 cache misses per emulated instruction,
+    *         or why the counters are unavailable
+    * @param  out: The output stream
+    * @param  results: Results measured with hardware_counters set
+    * @return None
+    */
+    static void writeCounterReport(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    /**
+    * @brief  Formats results with the host, build and benchmark settings they were measured with
+    * @param  suite: Name of the workload set ("synthetic" or "micro")
+    * @param  results: The results to format
+    * @return {"metadata": {...}, "results": [{"name", "instructions", "cycles", "seconds": [...], "counters": {...}}, ...]}
+    */
+    json toJSON(const std::string& suite, const std::vector<BenchmarkResult>& results) const;
+
+private:
+    const BenchmarkOptions options_;
+
+    /**
+    * @brief  Runs a workload once on a fresh machine
+    * @param  workload: The workload to run
+    * @param  image: Memory image of the workload
+    * @param  result: Receives the instruction and cycle counts
+    * @return Host seconds spent executing instructions
+    */
+    double runOnce(const BenchmarkWorkload& workload, const MemoryUnit& image, BenchmarkResult& result) const;
+
+    /**
+    * @brief  Runs one repetition of runScaling
+    * @param  workload: The workload to run
+    * @param  image: Memory image of the workload, also the shared ROM
+    * @param  layout: Whether instances share the program as ROM
+    * @param  result: Holds the thread and instance counts, receives the instruction and cycle totals
+    * @return Wall time in seconds from releasing the threads until the last one finished
+    */
+    double runScalingOnce(const BenchmarkWorkload& workload, const MemoryUnit& image, const MemoryLayout& layout, BenchmarkResult& result) const;
+};
+
+#endif
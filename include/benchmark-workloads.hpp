@@ -0,0 +1,51 @@
+#ifndef _BENCHMARK_WORKLOADS_HPP_
+#define _BENCHMARK_WORKLOADS_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+// Project Includes
+#include "memory-unit.hpp"
+
+#define WORKLOAD_LOAD_ADDRESS 0x0200
+#define WORKLOAD_DATA_ADDRESS 0x1000
+#define WORKLOAD_DATA_SIZE 0x0400
+#define MICROBENCHMARK_ENTRY_ADDRESS 0x0300
+
+// A self-contained 6502 program that runs forever, so it can be timed for any number of instructions
+struct BenchmarkWorkload {
+    std::string name;
+    std::string description;
+    // Code placed at WORKLOAD_LOAD_ADDRESS, which is also the reset vector
+    std::vector<uint8_t> program;
+    // Target of the IRQ and NMI vectors
+    uint16_t interrupt_handler;
+    // Instructions between IRQ requests, 0 never raises one
+    uint32_t irq_interval;
+};
+
+/**
+* @brief  Gets the bundled synthetic workloads
+* @param  None
+* @return Arithmetic, memory copy, sort, BCD, branch and interrupt heavy workloads
+*/
+const std::vector<BenchmarkWorkload>& syntheticWorkloads();
+
+/**
+* @brief  Gets one isolated loop per official opcode, plus page-cross variants of indexed modes
+*         and taken, taken page-cross and not-taken variants of branches
+*         Names are "<opcode> <mnemonic> <addressing mode> [variant]"
+* @param  None
+* @return The microbenchmark workloads, in opcode order
+*/
+std::vector<BenchmarkWorkload> microbenchmarkWorkloads();
+
+/**
+* @brief  Builds the 64kB memory image of a workload
+*         The program and vectors are written over a fixed pseudo random table at WORKLOAD_DATA_ADDRESS
+* @param  workload: The workload
+* @return The memory image
+*/
+MemoryUnit buildWorkloadImage(const BenchmarkWorkload& workload);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef _BUS_OBSERVER_HPP_
+#define _BUS_OBSERVER_HPP_
+// Standard Library Includes
+#include <cstdint>
+
+// Notified by BUS of every read and write, attached with BUS::addObserver
+//   Opcode and operand fetches are reads too, BUS::peekBusData is not reported
+class BusObserver {
+public:
+    virtual ~BusObserver() = default;
+
+    /**
+    * @brief  Called after data was read from the bus
+    * @param  address: The address read
+    * @param  data: The data read
+    * @return None
+    */
+    virtual void onRead(const uint16_t& address, const uint8_t& data) = 0;
+
+    /**
+    * @brief  Called before data is written to the bus, even when the write is ignored
+    * @param  address: The address written
+    * @param  data: The data written
+    * @return None
+    */
+    virtual void onWrite(const uint16_t& address, const uint8_t& data) = 0;
+};
+
+#endif
@@ -2,12 +2,26 @@
 #define _BUS_HPP_
 // Stardard Library Headers
 #include <cstdint>
+#include <vector>
 // Project Headers
 #include "mos6502.hpp"
 #include "memory-unit.hpp"
+#include "bus-observer.hpp"
 
 class BUS {
 public:
+    struct Activity {
+        enum class Type : uint8_t {
+            READ,
+            WRITE,
+        };
+        uint16_t address;
+        uint8_t data;
+        Type type;
+
+        bool operator==(const Activity& other) const = default;
+    };
+
     /**
     * @brief  Constructor for BUS
     * @param  cpu: CPU on the BUS
@@ -23,6 +37,13 @@ public:
     */
     uint8_t readBusData(const uint16_t& address) const;
     
+    /**
+    * @brief  Reads data at the address without recording it or notifying observers, for debuggers and reports
+    * @param  address: The address to read from
+    * @return Data the CPU would read at the address
+    */
+    uint8_t peekBusData(const uint16_t& address) const;
+
     /**
     * @brief  Writes data to the bus at the address
     * @param  address: The address to write to
@@ -31,9 +52,48 @@ public:
     */
     bool writeBusData(const uint16_t& address, const uint8_t& data);
 
+    /**
+    * @brief  Records every following read and write into recorder, in order
+    * @param  recorder: Where to append the bus activity, nullptr stops recording
+    * @return None
+    */
+    void setActivityRecorder(std::vector<Activity>* recorder);
+
+    /**
+    * @brief  Serves reads of [start_address, start_address + size) from rom instead of RAM and ignores writes to them
+    *         The ROM is only read, so several BUSes on different threads can share one
+    * @param  rom: Memory read at the same addresses as the CPU sees, nullptr unmaps it
+    * @param  start_address: First address of the ROM window
+    * @param  size: Size of the ROM window in bytes
+    * @return None
+    */
+    void mapROM(const MemoryUnit* rom, const uint16_t& start_address, const uint32_t& size);
+
+    /**
+    * @brief  Notifies observer of every following read and write, after the observers added before it
+    * @param  observer: The observer, must outlive its registration
+    * @return None
+    */
+    void addObserver(BusObserver* observer);
+
+    /**
+    * @brief  Stops notifying observer
+    * @param  observer: The observer to remove
+    * @return None
+    */
+    void removeObserver(BusObserver* observer);
+
 private:
     MOS6502& cpu_;
     MemoryUnit& ram_;
+    const MemoryUnit* rom_;
+    uint16_t rom_start_;
+    // 0 while no ROM is mapped, so the window check is a single unsigned compare
+    uint32_t rom_size_;
+    // Only checked for null on each access while recording is off
+    std::vector<Activity>* activity_recorder_;
+    // Only checked for emptiness on each access while nothing observes the bus
+    std::vector<BusObserver*> observers_;
 };
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef _CALL_GRAPH_PROFILER_HPP_
+#define _CALL_GRAPH_PROFILER_HPP_
+// Standard Library Includes
+#include <map>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "cpu-observer.hpp"
+#include "symbol-table.hpp"
+#include "shadow-call-stack.hpp"
+
+// Follows the emulated program's calls with a ShadowCallStack and attributes every instruction's cycles to the call path it ran in
+class CallGraphProfiler : public CPUObserver, private ShadowCallStack::Listener {
+public:
+    struct FunctionCycles {
+        uint16_t address;
+        uint64_t calls;
+        // Cycles of the function and everything it called, recursive calls counted once
+        uint64_t inclusive_cycles;
+        // Cycles of the function's own instructions
+        uint64_t exclusive_cycles;
+    };
+
+    /**
+    * @brief  Constructor for CallGraphProfiler
+    * @param  symbols: Names of functions, must outlive the profiler
+    * @return None
+    */
+    CallGraphProfiler(const SymbolTable& symbols);
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) override;
+
+    /**
+    * @brief  Gets the cycles of every function that was entered, the first executed address counts as the root function
+    * @param  None
+    * @return Calls, inclusive and exclusive cycles per function, most inclusive cycles first
+    */
+    std::vector<FunctionCycles> getFunctionCycles() const;
+
+    /**
+    * @brief  Writes one "outer;...;inner cycles" line per call path, the folded format flame graph tools read
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeFoldedStacks(std::ostream& out) const;
+
+    /**
+    * @brief  Writes the functions with the most inclusive cycles
+    * @param  out: The output stream
+    * @param  top: Number of functions to list
+    * @return None
+    */
+    void writeReport(std::ostream& out, const size_t& top) const;
+
+private:
+    // One node per distinct call path
+    struct CallNode {
+        uint16_t function;
+        uint32_t parent;
+        uint64_t calls;
+        uint64_t self_cycles;
+        std::map<uint16_t, uint32_t> children;
+    };
+
+    const SymbolTable& symbols_;
+    // nodes_[0] is the root path, children always come after their parent
+    std::vector<CallNode> nodes_;
+    ShadowCallStack shadow_call_stack_;
+    // Call path node of every shadow stack frame, outermost first
+    std::vector<uint32_t> frame_nodes_;
+    bool started_;
+
+    void onCall(const ShadowCallStack::Frame& frame) override;
+
+    void onReturn(const ShadowCallStack::Frame& frame) override;
+
+    void onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) override;
+
+    /**
+    * @brief  Gets the node of a call from a path, creating it on the first call
+    * @param  parent: Node of the calling path
+    * @param  function: Address of the called function
+    * @return Node of the call path
+    */
+    uint32_t childNode(const uint32_t& parent, const uint16_t& function);
+};
+
+#endif
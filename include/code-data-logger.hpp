@@ -0,0 +1,96 @@
+#ifndef _CODE_DATA_LOGGER_HPP_
+#define _CODE_DATA_LOGGER_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+// Project Includes
+#include "bus-observer.hpp"
+#include "cpu-observer.hpp"
+#include "source-map.hpp"
+
+// Keeps one flag byte per address recording how the program used it, the code/data log (CDL)
+//   Bus reads are told apart by where the CPU is: the first read of an instruction at the expected PC is the opcode,
+//   reads of the following instruction bytes are operands and every other access is data
+//   Attach it to the BUS and to the CPU
+class CodeDataLogger : public BusObserver, public CPUObserver {
+public:
+    // Flag bits of every address, also the byte layout of CDL files
+    enum Flag : uint8_t {
+        OPCODE = 0x01,
+        OPERAND = 0x02,
+        DATA_READ = 0x04,
+        DATA_WRITTEN = 0x08,
+        // Target of JMP (indirect) or the data address of a (zp,X) or (zp),Y access
+        INDIRECT_TARGET = 0x10,
+    };
+
+    /**
+    * @brief  Constructor for CodeDataLogger
+    * @param  None
+    * @return None
+    */
+    CodeDataLogger();
+
+    void onRead(const uint16_t& address, const uint8_t& data) override;
+
+    void onWrite(const uint16_t& address, const uint8_t& data) override;
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) override;
+
+    /**
+    * @brief  Gets the flags of an address
+    * @param  address: The address
+    * @return OR of Flag bits
+    */
+    uint8_t getFlags(const uint16_t& address) const;
+
+    /**
+    * @brief  ORs the flags of a CDL file into the log, so coverage can accumulate over several runs
+    * @param  file_path: Path to a 64kB CDL file
+    * @return None
+    */
+    void mergeCDL(const std::string& file_path);
+
+    /**
+    * @brief  Writes the flags of all 65536 addresses, one byte each
+    * @param  file_path: Path of the CDL file
+    * @return None
+    */
+    void writeCDL(const std::string& file_path) const;
+
+    /**
+    * @brief  Writes an lcov tracefile with one DA record per source line that assembled to code
+    *         A line counts as executed when any of its bytes was fetched as an opcode,
+    *         lines whose bytes were only accessed as data are left out
+    * @param  out: The output stream
+    * @param  source_map: Source lines of the program
+    * @return None
+    */
+    void writeLcov(std::ostream& out, const SourceMap& source_map) const;
+
+    /**
+    * @brief  Writes the number of addresses with each flag and the code, data and untouched bytes
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeReport(std::ostream& out) const;
+
+private:
+    std::vector<uint8_t> flags_;
+    // Address of the next opcode fetch, unknown until the first instruction
+    uint16_t next_opcode_address_;
+    bool expecting_opcode_;
+    bool started_;
+    // Operand bytes of the current instruction are [operand_start_, operand_start_ + operand_size_)
+    uint16_t operand_start_;
+    uint8_t operand_size_;
+    // Last data address the current instruction accessed
+    uint16_t last_data_address_;
+    bool data_accessed_;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef _CONFORMANCE_RUNNER_HPP_
+#define _CONFORMANCE_RUNNER_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <optional>
+#include <cstdint>
+// Project Includes
+#include "json-test-harness.hpp"
+#include "result-cache.hpp"
+
+struct ConformanceOptions {
+    // Directory holding one test file per opcode
+    std::string test_directory = "json-tests";
+    // Extension of the test files (".json" or ".bin")
+    std::string test_extension = ".json";
+    // Number of worker threads, 0 uses every hardware thread
+    unsigned int jobs = 0;
+    // Number of worker processes, 0 runs on threads instead
+    //   Worker processes always report quiet summaries and cannot time instructions
+    unsigned int processes = 0;
+    HarnessOptions harness;
+    // Result cache file, empty disables caching
+    std::string cache_path;
+    // Runs every opcode even if the cache holds a result for it, the cache is still updated
+    bool force_full_run = false;
+};
+
+// Runs the per-opcode test files on a pool of worker threads
+//   Each worker owns its own CPU, RAM and BUS, and results are reported in opcode order
+class ConformanceRunner {
+public:
+    struct OpcodeResult {
+        uint8_t opcode;
+        JSONTestHarness::Result result;
+        JSONTestHarness::Summary summary;
+        std::string log;
+        // Set when the result came from the cache instead of a run
+        bool cached;
+        // Cache key and test file hash, empty when caching is off
+        std::string cache_key;
+        ResultCache::FileHash test_file;
+        // Signal that killed the worker process testing this opcode, 0 if it did not crash
+        int crash_signal;
+    };
+
+    /**
+    * @brief  Constructor for ConformanceRunner
+    * @param  options: Test location, worker count and harness options
+    * @return None
+    */
+    ConformanceRunner(const ConformanceOptions& options);
+
+    /**
+    * @brief  Runs the tests of every official opcode
+    *         Verbose runs stop at the first failing opcode, quiet runs test every opcode and print one summary each
+    * @param  out: Stream that receives the test logs in opcode order
+    * @return True if every test passed, false otherwise
+    */
+    bool run(std::ostream& out);
+
+    /**
+    * @brief  Writes one JSON line per opcode that was run
+    * @param  file_path: Path of the result file
+    * @return True if successfully written, false otherwise
+    */
+    bool writeResults(const std::string& file_path) const;
+
+    /**
+    * @brief  Writes runInstruction timing percentiles per opcode and per addressing mode
+    *         Requires a run with HarnessOptions::time_instructions
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeBenchmarkReport(std::ostream& out) const;
+
+    /**
+    * @brief  Gets the opcodes that have a test file (the official ones)
+    * @param  None
+    * @return Official opcodes in ascending order
+    */
+    static std::vector<uint8_t> officialOpcodes();
+
+    /**
+    * @brief  Gets the path of the test file for an opcode
+    * @param  opcode: The opcode
+    * @return Path to the test file
+    */
+    std::string testFilePath(const uint8_t& opcode) const;
+
+    /**
+    * @brief  Runs every test of one opcode on a fresh CPU, RAM and BUS
+    * @param  opcode: The opcode to test
+    * @return Result and log of the run
+    */
+    OpcodeResult runOpcode(const uint8_t& opcode) const;
+
+private:
+    /**
+    * @brief  Tests the opcodes on a pool of threads, printing each log as soon as it is next in opcode order
+    * @param  opcodes: Opcodes to test
+    * @param  results: Receives the result of each opcode at its index
+    * @param  cache: The result cache, nullptr when caching is off
+    * @param  out: Stream that receives the test logs
+    * @return Number of leading results that were reported
+    */
+    size_t runWorkerThreads(const std::vector<uint8_t>& opcodes, std::vector<std::optional<OpcodeResult>>& results, const ResultCache* cache, std::ostream& out) const;
+
+    /**
+    * @brief  Tests the opcodes in forked worker processes that write into a shared-memory result table
+    *         Opcodes whose worker crashed are retried once, then reported as crashed
+    * @param  opcodes: Opcodes to test
+    * @param  results: Receives the result of each opcode at its index
+    * @param  cache: The result cache, nullptr when caching is off
+    * @param  out: Stream that receives the opcode summaries
+    * @return Number of leading results that were reported
+    */
+    size_t runWorkerProcesses(const std::vector<uint8_t>& opcodes, std::vector<std::optional<OpcodeResult>>& results, const ResultCache* cache, std::ostream& out) const;
+
+    /**
+    * @brief  Gets the result of one opcode from the cache, or by running its tests
+    * @param  opcode: The opcode to test
+    * @param  cache: The result cache, nullptr when caching is off
+    * @return Result and log of the opcode
+    */
+    OpcodeResult testOpcode(const uint8_t& opcode, const ResultCache* cache) const;
+
+    /**
+    * @brief  Writes the one line summary printed for an opcode in quiet mode
+    * @param  out: The output stream
+    * @param  opcode_result: Result of the opcode
+    * @return None
+    */
+    static void writeOpcodeSummary(std::ostream& out, const OpcodeResult& opcode_result);
+
+    ConformanceOptions options_;
+    unsigned int jobs_;
+    // Results of the last run in opcode order
+    std::vector<OpcodeResult> results_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef _CPU_OBSERVER_HPP_
+#define _CPU_OBSERVER_HPP_
+// Standard Library Includes
+#include <cstdint>
+
+// Forward Declares MOS6502 class
+class MOS6502;
+
+// Notified by MOS6502 of every executed instruction and interrupt, attached with MOS6502::addObserver
+//   Both runInstruction and runCycle notify once per instruction, when it executes
+class CPUObserver {
+public:
+    enum class Interrupt : uint8_t {
+        IRQ,
+        NMI,
+    };
+
+    virtual ~CPUObserver() = default;
+
+    /**
+    * @brief  Called after an instruction executed
+    * @param  cpu: The CPU, already in the state after the instruction
+    * @param  address: Address the opcode was fetched from
+    * @param  opcode: The executed opcode
+    * @param  cycles: Cycles of the instruction, including page-cross and branch cycles
+    * @return None
+    */
+    virtual void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) = 0;
+
+    /**
+    * @brief  Called after irq() or nmi() pushed the return address and status and jumped to the handler
+    *         BRK is an instruction and is only reported through onInstruction
+    * @param  cpu: The CPU, already at the first instruction of the handler
+    * @param  interrupt: Whether irq() or nmi() raised it, both may share a handler
+    * @param  return_address: Address execution resumes at after RTI
+    * @return None
+    */
+    virtual void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {}
+};
+
+#endif
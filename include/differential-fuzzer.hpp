@@ -0,0 +1,116 @@
+#ifndef _DIFFERENTIAL_FUZZER_HPP_
+#define _DIFFERENTIAL_FUZZER_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+// External Library Includes
+#include <nlohmann/json.hpp>
+// Project Includes
+#include "bus.hpp"
+#include "mos6502.hpp"
+#include "memory-unit.hpp"
+#include "execution-engine.hpp"
+// Using shorthand declarations
+using json = nlohmann::json;
+
+struct FuzzOptions {
+    uint64_t seed = 1;
+    uint64_t cases = 100000;
+    // Number of worker threads, 0 uses every hardware thread
+    unsigned int jobs = 0;
+    // Length of the random opcode stream run by each case
+    uint32_t instructions_per_case = 16;
+    std::string reference_engine = "instruction";
+    std::string candidate_engine = "cycle";
+    // Stop fuzzing once this many mismatches are known
+    uint64_t max_mismatches = 64;
+    // Directory that receives one SingleStepTests file per mismatching opcode
+    std::string output_directory = "fuzz-failures";
+};
+
+// Generates random CPU states, memory and opcode streams, runs them on two execution engines
+//   and reduces every mismatch to a single instruction test case in the SingleStepTests format
+//   Each case is derived from (seed, case index) alone, so a run is reproducible whatever the thread count
+class DifferentialFuzzer {
+public:
+    struct Mismatch {
+        uint64_t case_index;
+        uint8_t opcode;
+        // Minimized test case, final State, RAM and cycles are the reference engine's
+        json test_case;
+    };
+
+    /**
+    * @brief  Constructor for DifferentialFuzzer
+    * @param  options: Seed, case count, engines and output directory
+    * @return None
+    */
+    DifferentialFuzzer(const FuzzOptions& options);
+
+    /**
+    * @brief  Runs every case over the worker threads and saves the minimized mismatches
+    * @param  out: Stream that receives progress and the final report
+    * @return Mismatches found, ordered by case index
+    */
+    std::vector<Mismatch> run(std::ostream& out);
+
+private:
+    const FuzzOptions options_;
+    const ExecutionEngine& reference_engine_;
+    const ExecutionEngine& candidate_engine_;
+    const unsigned int jobs_;
+
+    // Outcome of one instruction on one engine
+    struct StepResult {
+        MOS6502::State state;
+        uint64_t cycles;
+        std::vector<BUS::Activity> bus_activity;
+        std::vector<std::pair<uint16_t, uint8_t>> touched_memory;
+    };
+
+    /**
+    * @brief  Runs one random case and minimizes it if the engines disagree
+    * @param  case_index: Index of the case, combined with the seed to derive it
+    * @param  mismatch: Receives the minimized mismatch
+    * @return True if the engines disagreed, false otherwise
+    */
+    bool runCase(const uint64_t& case_index, Mismatch& mismatch) const;
+
+    /**
+    * @brief  Runs a single instruction on a fresh machine
+    * @param  engine: The engine to run it on
+    * @param  image: Initial memory
+    * @param  state: Initial CPU State
+    * @return State, cycles, bus activity and final value of every touched address
+    */
+    static StepResult step(const ExecutionEngine& engine, const MemoryUnit& image, const MOS6502::State& state);
+
+    /**
+    * @brief  Checks whether two single instruction results differ
+    * @param  reference: Result of the reference engine
+    * @param  candidate: Result of the candidate engine
+    * @return True if State, cycles or memory writes differ
+    */
+    static bool differs(const StepResult& reference, const StepResult& candidate);
+
+    /**
+    * @brief  Shrinks a mismatching instruction to the memory it touches and zeroes every register or byte
+    *         that is not needed to reproduce the mismatch, then formats it as a test case
+    * @param  image: Memory right before the mismatching instruction
+    * @param  state: CPU State right before the mismatching instruction
+    * @param  name: Name of the test case
+    * @return The test case
+    */
+    json minimize(const MemoryUnit& image, MOS6502::State state, const std::string& name) const;
+
+    /**
+    * @brief  Writes the mismatches into one JSON file per opcode
+    * @param  mismatches: The mismatches to write
+    * @return None
+    */
+    void saveMismatches(const std::vector<Mismatch>& mismatches) const;
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef _DISASSEMBLER_HPP_
+#define _DISASSEMBLER_HPP_
+// Standard Library Includes
+#include <string>
+#include <cstdint>
+// Project Includes
+#include "memory-unit.hpp"
+
+/**
+* @brief  Disassembles the instruction at address, e.g. "LDA $1000,X" or "BNE $0204"
+*         Unofficial opcodes print as "???", relative branches print their target
+* @param  memory: Memory holding the program
+* @param  address: Address of the opcode
+* @return The instruction in assembler syntax
+*/
+std::string disassembleInstruction(const MemoryUnit& memory, const uint16_t& address);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef _EXECUTION_ENGINE_HPP_
+#define _EXECUTION_ENGINE_HPP_
+// Standard Library Includes
+#include <array>
+#include <string_view>
+// Project Includes
+#include "mos6502.hpp"
+
+// A way of driving the CPU one instruction at a time
+//   Every engine must leave the CPU in the same State and perform the same bus writes per instruction,
+//   which is what the lockstep runner and the differential fuzzer check
+struct ExecutionEngine {
+    std::string_view name;
+    // Brings a freshly connected CPU to the boundary of its first instruction
+    void (*prepare)(MOS6502& cpu);
+    // Executes exactly one instruction
+    void (*stepInstruction)(MOS6502& cpu);
+};
+
+// Usage: Engines that can be selected by name, the first one is the reference
+extern const std::array<ExecutionEngine, 2> execution_engines;
+
+/**
+* @brief  Finds an execution engine by name
+* @param  name: Name of the engine
+* @return The engine, nullptr if there is no engine with that name
+*/
+const ExecutionEngine* findExecutionEngine(const std::string_view& name);
+
+#endif
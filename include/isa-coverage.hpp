@@ -0,0 +1,98 @@
+#ifndef _ISA_COVERAGE_HPP_
+#define _ISA_COVERAGE_HPP_
+// Standard Library Includes
+#include <array>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "cpu-observer.hpp"
+#include "mos6502.hpp"
+
+// Forward Declares BUS class
+class BUS;
+
+// Records which behaviours of the instruction set a run exercised
+//   Every opcode the instruction table names is one coverage point, indexed addressing (ABX, ABY, IZY) adds staying in and crossing the
+//   base page, branches add not taken, taken within the page and taken to another page, and ADC/SBC and CMP/CPX/CPY
+//   add every combination of the flags they set that the ALU can produce
+class ISACoverage : public CPUObserver {
+public:
+    struct OpcodeCoverage {
+        uint64_t executions;
+        // Indexed accesses that stayed in the base page, or branches taken within the page
+        uint64_t same_page;
+        // Indexed accesses that crossed into the next page, or branches taken to another page
+        uint64_t page_crosses;
+        uint64_t branches_not_taken;
+        // Results of ADC/SBC and CMP/CPX/CPY, indexed by the N, V, Z and C flags as bits 3 to 0
+        std::array<uint64_t, 16> flag_results;
+    };
+
+    struct CategoryCoverage {
+        std::string category;
+        size_t covered;
+        size_t total;
+    };
+
+    /**
+    * @brief  Constructor for ISACoverage
+    * @param  bus: The bus the CPU runs on, peeked for the operands of indexed instructions, must outlive the coverage
+    * @return None
+    */
+    ISACoverage(const BUS& bus);
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    /**
+    * @brief  Gets what was recorded for every opcode
+    * @param  None
+    * @return Coverage indexed by opcode
+    */
+    const std::array<OpcodeCoverage, MOS6502_NUMBER_OF_INSTRUCTIONS>& getOpcodeCoverage() const;
+
+    /**
+    * @brief  Gets the covered and total points of every category
+    * @param  None
+    * @return Opcodes, indexed page crossing, branch outcomes and ADC/SBC and compare flag results, then the total
+    */
+    std::vector<CategoryCoverage> getSummary() const;
+
+    /**
+    * @brief  Gets every coverage point that was never reached
+    * @param  None
+    * @return Descriptions such as "$7D ADC ABX page cross", in opcode order
+    */
+    std::vector<std::string> getUncovered() const;
+
+    /**
+    * @brief  Writes the summary table followed by the first uncovered points
+    * @param  out: The output stream
+    * @param  top: Number of uncovered points to list
+    * @return None
+    */
+    void writeReport(std::ostream& out, const size_t& top) const;
+
+    /**
+    * @brief  Writes the counts of every named opcode as JSON, for comparing the coverage of workloads
+    *         [{"opcode", "name", "addressing_mode", "executions", "same_page", "page_crosses", "branches_not_taken", "flag_results"}, ...]
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeJSON(std::ostream& out) const;
+
+private:
+    const BUS& bus_;
+    std::array<OpcodeCoverage, MOS6502_NUMBER_OF_INSTRUCTIONS> coverage_;
+
+    /**
+    * @brief  Gets the flag combinations an opcode can produce
+    * @param  opcode: The opcode
+    * @return Reachable combinations indexed like flag_results, all false for opcodes whose flag results are not covered
+    */
+    static const std::array<bool, 16>& reachableFlagResults(const uint8_t& opcode);
+};
+
+#endif
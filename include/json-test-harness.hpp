@@ -2,13 +2,26 @@
 #define _JSON_TEST_HARNESS_HPP_
 // Standard Library Includes
 #include <string>
+#include <ostream>
+#include <iostream>
+#include <sstream>
+#include <optional>
 #include <cstdint>
-// External Library Includes
-#include <nlohmann/json.hpp>
+#include <span>
+#include <vector>
 // Project Includes
+#include "bus.hpp"
 #include "mos6502.hpp"
-// Using shorthand declarations
-using json = nlohmann::json;
+#include "test-corpus.hpp"
+
+struct HarnessOptions {
+    // Only failures are recorded, nothing is printed per test case
+    bool quiet = false;
+    // Records every bus read and write of the instruction and compares them with the test's per-cycle activity
+    bool verify_bus = false;
+    // Times the runInstruction call of each test case, setup and checks are excluded
+    bool time_instructions = false;
+};
 
 class JSONTestHarness {
 public:
@@ -18,13 +31,26 @@ public:
         ALL_TESTS_PASSED,
     };
 
+    struct Summary {
+        uint32_t tests_run;
+        uint32_t tests_passed;
+        std::optional<uint32_t> first_failure_index;
+        std::string first_failure_name;
+        // Failure messages followed by every register, cycle count and final RAM address, got vs expected
+        std::string first_failure_diff;
+        // Nanoseconds spent in runInstruction per test case, only filled when timing instructions
+        std::vector<uint32_t> instruction_times_ns;
+    };
+
     /**
     * @brief  Constructor for JSONTestHarness
     * @param  cpu: Target CPU
-    * @param  file_path: Path to JSON File
+    * @param  file_path: Path to JSON File or binary test corpus
+    * @param  out: Stream that receives the test log
+    * @param  options: Harness options
     * @return None
     */
-    JSONTestHarness(MOS6502& cpu, const std::string& file_path);
+    JSONTestHarness(MOS6502& cpu, const std::string& file_path, std::ostream& out = std::cout, const HarnessOptions& options = HarnessOptions{});
 
     /**
     * @brief  Executes a single instruction
@@ -32,11 +58,84 @@ public:
     * @return Result of the test
     */
     Result singleInstructionStep();
-    
+
+    /**
+    * @brief  Runs every remaining test case, continuing past failures
+    * @param  None
+    * @return Summary of every test case run so far
+    */
+    Summary runAllTests();
+
+    /**
+    * @brief  Gets the summary of every test case run so far
+    * @param  None
+    * @return Summary of the run
+    */
+    const Summary& getSummary() const;
+
 private:
     uint32_t instructions_tested_;
     MOS6502& cpu_;
-    json test_json_;
+    std::ostream& out_;
+    HarnessOptions options_;
+    TestCorpus test_corpus_;
+    Summary summary_;
+    // Failure messages of the current case, only printed in verbose mode
+    std::ostringstream failure_log_;
+    uint64_t last_cycle_count_;
+    // Bus activity of the current case, only filled when verifying the bus
+    std::vector<BUS::Activity> bus_activity_;
+    // Original values of the addresses the current case touches
+    std::vector<TestCorpus::RAMEntry> touched_memory_;
+
+    /**
+    * @brief  Loads a test file, converting JSON to the in-memory corpus format
+    * @param  file_path: Path to JSON File or binary test corpus
+    * @return The loaded corpus
+    */
+    static TestCorpus loadTestCorpus(const std::string& file_path);
+
+    /**
+    * @brief  Runs the current test case, updates the summary and restores the RAM
+    * @param  None
+    * @return Result of the test
+    */
+    Result runCurrentTestCase();
+
+    /**
+    * @brief  Runs and checks the current test case
+    * @param  None
+    * @return Result of the test
+    */
+    Result runTestCase();
+
+    /**
+    * @brief  Saves the current values of the given addresses so they can be restored
+    * @param  ram_entries: Addresses the current case touches
+    * @return None
+    */
+    void recordTouchedMemory(const std::span<const TestCorpus::RAMEntry>& ram_entries);
+
+    /**
+    * @brief  Restores every address saved by recordTouchedMemory
+    * @param  None
+    * @return None
+    */
+    void restoreTouchedMemory();
+
+    /**
+    * @brief  Writes the final CPU state, cycle count and RAM of the current case next to the expected values
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeStateDiff(std::ostream& out) const;
+
+    /**
+    * @brief  Writes the recorded bus activity of the current case next to the expected activity
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeBusActivityDiff(std::ostream& out) const;
 };
 
 #endif
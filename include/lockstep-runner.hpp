@@ -0,0 +1,110 @@
+#ifndef _LOCKSTEP_RUNNER_HPP_
+#define _LOCKSTEP_RUNNER_HPP_
+// Standard Library Includes
+#include <vector>
+#include <optional>
+#include <memory>
+#include <ostream>
+#include <cstdint>
+// Project Includes
+#include "bus.hpp"
+#include "mos6502.hpp"
+#include "memory-unit.hpp"
+#include "execution-engine.hpp"
+
+// Runs the same program on two execution engines, each with its own clone of the memory,
+//   and stops at the first instruction window where their State, cycle count or memory writes differ
+class LockstepRunner {
+public:
+    struct Machine {
+        MOS6502 cpu;
+        MemoryUnit ram;
+        BUS bus;
+        // Bus activity since the last comparison
+        std::vector<BUS::Activity> bus_activity;
+        uint64_t compared_cycles;
+
+        /**
+        * @brief  Constructor for Machine
+        * @param  image: Memory to clone into the machine's RAM
+        * @return None
+        */
+        Machine(const MemoryUnit& image);
+    };
+
+    struct Divergence {
+        // Instructions [first_instruction, last_instruction] ran since the last matching comparison
+        uint64_t first_instruction;
+        uint64_t last_instruction;
+        MOS6502::State reference_state;
+        MOS6502::State candidate_state;
+        uint64_t reference_cycles;
+        uint64_t candidate_cycles;
+        std::vector<BUS::Activity> reference_writes;
+        std::vector<BUS::Activity> candidate_writes;
+    };
+
+    /**
+    * @brief  Constructor for LockstepRunner
+    * @param  image: Initial memory, cloned for each engine
+    * @param  reference: The engine that is trusted
+    * @param  candidate: The engine being validated
+    * @param  initial_state: State to start from, std::nullopt starts from the reset vector
+    * @return None
+    */
+    LockstepRunner(const MemoryUnit& image, const ExecutionEngine& reference, const ExecutionEngine& candidate, const std::optional<MOS6502::State>& initial_state = std::nullopt);
+
+    /**
+    * @brief  Runs both engines until they diverge or the instruction budget is spent
+    * @param  max_instructions: Number of instructions to run
+    * @param  compare_interval: Compare the machines every this many instructions
+    * @return The first divergence, std::nullopt if the engines agreed throughout
+    */
+    std::optional<Divergence> run(const uint64_t& max_instructions, const uint64_t& compare_interval = 1);
+
+    /**
+    * @brief  Gets the number of instructions each engine has executed
+    * @param  None
+    * @return Instructions executed
+    */
+    uint64_t getInstructionsExecuted() const;
+
+    /**
+    * @brief  Gets the machine driven by the reference engine
+    * @param  None
+    * @return The reference machine
+    */
+    const Machine& getReferenceMachine() const;
+
+    /**
+    * @brief  Writes both states, cycle counts and write sequences of a divergence
+    * @param  out: The output stream
+    * @param  divergence: The divergence to describe
+    * @return None
+    */
+    void writeDivergence(std::ostream& out, const Divergence& divergence) const;
+
+    /**
+    * @brief  Filters recorded bus activity down to the memory writes, the only activity both engines must match
+    * @param  bus_activity: Bus activity in the order it happened
+    * @return The writes in the order they happened
+    */
+    static std::vector<BUS::Activity> memoryWrites(const std::vector<BUS::Activity>& bus_activity);
+
+private:
+    const ExecutionEngine& reference_engine_;
+    const ExecutionEngine& candidate_engine_;
+    std::unique_ptr<Machine> reference_;
+    std::unique_ptr<Machine> candidate_;
+    uint64_t instructions_executed_;
+    uint64_t compared_instructions_;
+
+    /**
+    * @brief  Compares the machines and clears their recorded bus activity
+    * @param  None
+    * @return The divergence if the machines differ, std::nullopt otherwise
+    */
+    std::optional<Divergence> compare();
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef _MEMORY_HEATMAP_HPP_
+#define _MEMORY_HEATMAP_HPP_
+// Standard Library Includes
+#include <array>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "bus-observer.hpp"
+#include "cpu-observer.hpp"
+
+// Counts reads, writes and executed opcodes of every address
+//   Attach it to the BUS for reads and writes and to the CPU for opcode fetches
+//   Heatmaps are 256x256, one row per page and one column per byte of the page
+class MemoryHeatmap : public BusObserver, public CPUObserver {
+public:
+    enum class Access {
+        READ,
+        WRITE,
+        EXECUTE,
+        // Sum of reads, writes and executes
+        ALL,
+    };
+
+    /**
+    * @brief  Constructor for MemoryHeatmap
+    * @param  None
+    * @return None
+    */
+    MemoryHeatmap();
+
+    void onRead(const uint16_t& address, const uint8_t& data) override;
+
+    void onWrite(const uint16_t& address, const uint8_t& data) override;
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    /**
+    * @brief  Gets how often an address was accessed
+    * @param  address: The address
+    * @param  access: Which accesses to count
+    * @return Number of accesses
+    */
+    uint64_t getCount(const uint16_t& address, const Access& access) const;
+
+    /**
+    * @brief  Writes a binary 8-bit grayscale PGM, brightness is log scaled between 0 and the busiest address
+    * @param  out: The output stream, opened in binary mode
+    * @param  access: Which accesses to draw
+    * @return None
+    */
+    void writePGM(std::ostream& out, const Access& access) const;
+
+    /**
+    * @brief  Writes a binary PPM with writes in red, reads in green and executes in blue, each log scaled on its own
+    * @param  out: The output stream, opened in binary mode
+    * @return None
+    */
+    void writePPM(std::ostream& out) const;
+
+    /**
+    * @brief  Writes 256 lines of 256 comma separated counts, line N holds page N
+    * @param  out: The output stream
+    * @param  access: Which accesses to write
+    * @return None
+    */
+    void writeCSV(std::ostream& out, const Access& access) const;
+
+    /**
+    * @brief  Writes the working set size and the busiest zero page and absolute data addresses,
+    *         the latter being candidates to move into zero page
+    * @param  out: The output stream
+    * @param  top: Number of addresses to list per group
+    * @return None
+    */
+    void writeReport(std::ostream& out, const size_t& top) const;
+
+private:
+    std::vector<uint64_t> reads_;
+    std::vector<uint64_t> writes_;
+    std::vector<uint64_t> executes_;
+    // Length of the instruction last executed at each address, so reports can tell operand fetches from data reads
+    std::vector<uint8_t> instruction_lengths_;
+
+    /**
+    * @brief  Scales the counts of an access type to 0-255 on a log scale
+    * @param  access: Which accesses to scale
+    * @return One brightness per address
+    */
+    std::vector<uint8_t> scaledCounts(const Access& access) const;
+};
+
+#endif
@@ -21,6 +21,13 @@ public:
     */
     MemoryUnit(std::ifstream& file_in);
 
+    /**
+    * @brief  Copy Constructor for RAM, clones the memory contents
+    * @param  other: The RAM to clone
+    * @return None
+    */
+    MemoryUnit(const MemoryUnit& other);
+
     /**
     * @brief  Reads 1 byte of data at given memory address
     * @param  address: The memory address to read
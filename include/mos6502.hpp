@@ -5,6 +5,11 @@
 #include <ostream>
 #include <array>
 #include <variant>
+#include <string>
+#include <string_view>
+#include <vector>
+// Project Headers
+#include "cpu-observer.hpp"
 
 #define MOS6502_NMI_PC_ADDRESS 0xFFFA
 #define MOS6502_STARTING_PC_ADDRESS 0xFFFC
@@ -24,11 +29,27 @@ public:
         ACCEPTS_ADDITIONAL_CYCLES,
     };
 
+    // Identifies an addressing mode handler without comparing function pointers
+    enum class AddressingMode : uint8_t {
+        IMP, IMM, ZP0, ZPX, ZPY, REL, ABS, ABX, ABY, IND, IZX, IZY,
+    };
+
+    // Identifies an operation handler, unofficial opcodes map to NOP or XXX
+    enum class Operation : uint8_t {
+        ADC, AND, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRK, BVC, BVS, CLC,
+        CLD, CLI, CLV, CMP, CPX, CPY, DEC, DEX, DEY, EOR, INC, INX, INY, JMP,
+        JSR, LDA, LDX, LDY, LSR, NOP, ORA, PHA, PHP, PLA, PLP, ROL, ROR, RTI,
+        RTS, SBC, SEC, SED, SEI, STA, STX, STY, TAX, TAY, TSX, TXA, TXS, TYA,
+        XXX,
+    };
+
     struct Instruction {
-        const std::string name;
+        const std::string_view name;
         CycleType (*operationFn)(MOS6502& cpu);
         uint8_t (*addressingMode)(MOS6502& cpu);
         uint8_t cycles;
+        Operation operation;
+        AddressingMode addressing_mode;
     };
 
     struct State {
@@ -38,11 +59,57 @@ public:
         uint8_t x_reg;
         uint8_t y_reg;
         uint8_t processor_status;
+
+        bool operator==(const State& other) const = default;
     };
 
-    // Usage: Maps OPCODE to Instruction
+#ifdef MOS6502_OPCODE_COUNTERS
+    struct OpcodeCounter {
+        uint64_t executions;
+        uint64_t cycles;
+        // Extra cycles taken because an indexed address or a branch target crossed a page
+        uint64_t page_cross_penalties;
+    };
+#endif
+
+    // Usage: Maps OPCODE to Instruction, defined constexpr below the class
     static const std::array<Instruction, MOS6502_NUMBER_OF_INSTRUCTIONS> instruction_lookup_table;
 
+    // Usage: Maps AddressingMode to its three letter name
+    static constexpr std::array<std::string_view, 12> addressing_mode_names = {
+        "IMP", "IMM", "ZP0", "ZPX", "ZPY", "REL", "ABS", "ABX", "ABY", "IND", "IZX", "IZY",
+    };
+
+    // Usage: Maps Operation to the name of its handler, unofficial opcodes included
+    static constexpr std::array<std::string_view, 57> operation_names = {
+        "ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC", "BVS", "CLC",
+        "CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX", "DEY", "EOR", "INC", "INX", "INY", "JMP",
+        "JSR", "LDA", "LDX", "LDY", "LSR", "NOP", "ORA", "PHA", "PHP", "PLA", "PLP", "ROL", "ROR", "RTI",
+        "RTS", "SBC", "SEC", "SED", "SEI", "STA", "STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA",
+        "XXX",
+    };
+
+    /**
+    * @brief  Gets the name of the operation handler an opcode runs, unlike Instruction::name it is never "???"
+    * @param  opcode: The opcode
+    * @return Three letter operation name (ADC, AND, ..., NOP, XXX)
+    */
+    static constexpr std::string_view getOperationName(const uint8_t& opcode);
+
+    /**
+    * @brief  Gets the addressing mode name of an opcode
+    * @param  opcode: The opcode
+    * @return Three letter addressing mode name (IMP, IMM, ZP0, ...)
+    */
+    static constexpr std::string_view getAddressingModeName(const uint8_t& opcode);
+
+    /**
+    * @brief  Gets the length of an instruction from its addressing mode
+    * @param  opcode: The opcode
+    * @return Size in bytes of the opcode and its operand
+    */
+    static constexpr uint8_t getInstructionLength(const uint8_t& opcode);
+
     /**
     * @brief  Constructor for MOS6502
     * @param  None
@@ -57,6 +124,13 @@ public:
     */
     void connectBUS(BUS* target_bus);
 
+    /**
+    * @brief  Gets the BUS the CPU is connected to
+    * @param  None
+    * @return The connected BUS, nullptr if not connected
+    */
+    BUS* getConnectedBUS() const;
+
     /**
     * @brief  Run 1 instruction of the CPU
     * @param  None
@@ -99,6 +173,13 @@ public:
     */
     uint64_t getCyclesElapsed() const;
 
+    /**
+    * @brief  Gets the number of cycles left before runCycle fetches the next instruction
+    * @param  None
+    * @return Cycles remaining for the current instruction
+    */
+    uint8_t getInstructionCyclesRemaining() const;
+
     /**
     * @brief  Gets the current state of the CPU
     * @param  None
@@ -113,6 +194,51 @@ public:
     */
     void setState(const State& new_state);
 
+    /**
+    * @brief  Notifies observer of every following instruction, after the observers added before it
+    * @param  observer: The observer, must outlive its registration
+    * @return None
+    */
+    void addObserver(CPUObserver* observer);
+
+    /**
+    * @brief  Stops notifying observer
+    * @param  observer: The observer to remove
+    * @return None
+    */
+    void removeObserver(CPUObserver* observer);
+
+#ifdef MOS6502_OPCODE_COUNTERS
+    /**
+    * @brief  Gets the executions, cycles and page-cross penalties counted for every opcode
+    * @param  None
+    * @return Counters indexed by opcode
+    */
+    const std::array<OpcodeCounter, MOS6502_NUMBER_OF_INSTRUCTIONS>& getOpcodeCounters() const;
+
+    /**
+    * @brief  Zeroes every opcode counter
+    * @param  None
+    * @return None
+    */
+    void resetOpcodeCounters();
+
+    /**
+    * @brief  Writes the executed opcodes as a table, most executed first
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeOpcodeCounterTable(std::ostream& out) const;
+
+    /**
+    * @brief  Writes the executed opcodes as a JSON array in opcode order
+    *         [{"opcode", "name", "addressing_mode", "executions", "cycles", "page_cross_penalties"}, ...]
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeOpcodeCounterJSON(std::ostream& out) const;
+#endif
+
     /**
     * @brief  Output the current CPU state
     * @param  out: The output stream
@@ -204,6 +330,26 @@ private:
     const Instruction* instruction_; // Current fetched instruction
     uint8_t instruction_opcode_; // Current fetched instruction's opcode
     uint8_t instruction_cycle_remaining_; // Cycles remaining for the current instruction to complete
+    // Only checked for emptiness on each instruction while nothing observes the CPU
+    std::vector<CPUObserver*> observers_;
+
+    /**
+    * @brief  Notifies every observer of the instruction just executed
+    * @param  instruction_address: Address the opcode was fetched from
+    * @return None
+    */
+    void notifyObservers(const uint16_t& instruction_address) const;
+
+#ifdef MOS6502_OPCODE_COUNTERS
+    std::array<OpcodeCounter, MOS6502_NUMBER_OF_INSTRUCTIONS> opcode_counters_{};
+
+    /**
+    * @brief  Counts the instruction just decoded, once its cycles are final
+    * @param  additional_cycles: Page-cross cycles of the addressing mode that were added
+    * @return None
+    */
+    void countOpcode(const uint8_t& additional_cycles);
+#endif
     
     // Variables that emulates the data carried on a data-path
     Pointer operand_address_;
@@ -722,4 +868,55 @@ private:
     static uint8_t IZY(MOS6502& cpu);
 };
 
+// Thanks to One Lone Coder for the opcode table
+//   Defined in the header as constexpr so it needs no static initialization and can be used in constant expressions
+#define MOS6502_INSTRUCTION(name, operation, addressing_mode, cycles) \
+    { name, MOS6502::operation, MOS6502::addressing_mode, cycles, MOS6502::Operation::operation, MOS6502::AddressingMode::addressing_mode }
+inline constexpr std::array<MOS6502::Instruction, MOS6502_NUMBER_OF_INSTRUCTIONS> MOS6502::instruction_lookup_table = {{
+    MOS6502_INSTRUCTION("BRK", BRK, IMM, 7), MOS6502_INSTRUCTION("ORA", ORA, IZX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 3), MOS6502_INSTRUCTION("ORA", ORA, ZP0, 3), MOS6502_INSTRUCTION("ASL", ASL, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("PHP", PHP, IMP, 3), MOS6502_INSTRUCTION("ORA", ORA, IMM, 2), MOS6502_INSTRUCTION("ASL", ASL, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("ORA", ORA, ABS, 4), MOS6502_INSTRUCTION("ASL", ASL, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BPL", BPL, REL, 2), MOS6502_INSTRUCTION("ORA", ORA, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("ORA", ORA, ZPX, 4), MOS6502_INSTRUCTION("ASL", ASL, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("CLC", CLC, IMP, 2), MOS6502_INSTRUCTION("ORA", ORA, ABY, 4), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("ORA", ORA, ABX, 4), MOS6502_INSTRUCTION("ASL", ASL, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+    MOS6502_INSTRUCTION("JSR", JSR, ABS, 6), MOS6502_INSTRUCTION("AND", AND, IZX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("BIT", BIT, ZP0, 3), MOS6502_INSTRUCTION("AND", AND, ZP0, 3), MOS6502_INSTRUCTION("ROL", ROL, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("PLP", PLP, IMP, 4), MOS6502_INSTRUCTION("AND", AND, IMM, 2), MOS6502_INSTRUCTION("ROL", ROL, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("BIT", BIT, ABS, 4), MOS6502_INSTRUCTION("AND", AND, ABS, 4), MOS6502_INSTRUCTION("ROL", ROL, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BMI", BMI, REL, 2), MOS6502_INSTRUCTION("AND", AND, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("AND", AND, ZPX, 4), MOS6502_INSTRUCTION("ROL", ROL, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("SEC", SEC, IMP, 2), MOS6502_INSTRUCTION("AND", AND, ABY, 4), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("AND", AND, ABX, 4), MOS6502_INSTRUCTION("ROL", ROL, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+    MOS6502_INSTRUCTION("RTI", RTI, IMP, 6), MOS6502_INSTRUCTION("EOR", EOR, IZX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 3), MOS6502_INSTRUCTION("EOR", EOR, ZP0, 3), MOS6502_INSTRUCTION("LSR", LSR, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("PHA", PHA, IMP, 3), MOS6502_INSTRUCTION("EOR", EOR, IMM, 2), MOS6502_INSTRUCTION("LSR", LSR, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("JMP", JMP, ABS, 3), MOS6502_INSTRUCTION("EOR", EOR, ABS, 4), MOS6502_INSTRUCTION("LSR", LSR, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BVC", BVC, REL, 2), MOS6502_INSTRUCTION("EOR", EOR, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("EOR", EOR, ZPX, 4), MOS6502_INSTRUCTION("LSR", LSR, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("CLI", CLI, IMP, 2), MOS6502_INSTRUCTION("EOR", EOR, ABY, 4), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("EOR", EOR, ABX, 4), MOS6502_INSTRUCTION("LSR", LSR, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+    MOS6502_INSTRUCTION("RTS", RTS, IMP, 6), MOS6502_INSTRUCTION("ADC", ADC, IZX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 3), MOS6502_INSTRUCTION("ADC", ADC, ZP0, 3), MOS6502_INSTRUCTION("ROR", ROR, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("PLA", PLA, IMP, 4), MOS6502_INSTRUCTION("ADC", ADC, IMM, 2), MOS6502_INSTRUCTION("ROR", ROR, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("JMP", JMP, IND, 5), MOS6502_INSTRUCTION("ADC", ADC, ABS, 4), MOS6502_INSTRUCTION("ROR", ROR, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BVS", BVS, REL, 2), MOS6502_INSTRUCTION("ADC", ADC, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("ADC", ADC, ZPX, 4), MOS6502_INSTRUCTION("ROR", ROR, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("SEI", SEI, IMP, 2), MOS6502_INSTRUCTION("ADC", ADC, ABY, 4), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("ADC", ADC, ABX, 4), MOS6502_INSTRUCTION("ROR", ROR, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+    MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("STA", STA, IZX, 6), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("STY", STY, ZP0, 3), MOS6502_INSTRUCTION("STA", STA, ZP0, 3), MOS6502_INSTRUCTION("STX", STX, ZP0, 3), MOS6502_INSTRUCTION("???", XXX, IMP, 3), MOS6502_INSTRUCTION("DEY", DEY, IMP, 2), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("TXA", TXA, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("STY", STY, ABS, 4), MOS6502_INSTRUCTION("STA", STA, ABS, 4), MOS6502_INSTRUCTION("STX", STX, ABS, 4), MOS6502_INSTRUCTION("???", XXX, IMP, 4),
+    MOS6502_INSTRUCTION("BCC", BCC, REL, 2), MOS6502_INSTRUCTION("STA", STA, IZY, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("STY", STY, ZPX, 4), MOS6502_INSTRUCTION("STA", STA, ZPX, 4), MOS6502_INSTRUCTION("STX", STX, ZPY, 4), MOS6502_INSTRUCTION("???", XXX, IMP, 4), MOS6502_INSTRUCTION("TYA", TYA, IMP, 2), MOS6502_INSTRUCTION("STA", STA, ABY, 5), MOS6502_INSTRUCTION("TXS", TXS, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("???", NOP, IMP, 5), MOS6502_INSTRUCTION("STA", STA, ABX, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5),
+    MOS6502_INSTRUCTION("LDY", LDY, IMM, 2), MOS6502_INSTRUCTION("LDA", LDA, IZX, 6), MOS6502_INSTRUCTION("LDX", LDX, IMM, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("LDY", LDY, ZP0, 3), MOS6502_INSTRUCTION("LDA", LDA, ZP0, 3), MOS6502_INSTRUCTION("LDX", LDX, ZP0, 3), MOS6502_INSTRUCTION("???", XXX, IMP, 3), MOS6502_INSTRUCTION("TAY", TAY, IMP, 2), MOS6502_INSTRUCTION("LDA", LDA, IMM, 2), MOS6502_INSTRUCTION("TAX", TAX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("LDY", LDY, ABS, 4), MOS6502_INSTRUCTION("LDA", LDA, ABS, 4), MOS6502_INSTRUCTION("LDX", LDX, ABS, 4), MOS6502_INSTRUCTION("???", XXX, IMP, 4),
+    MOS6502_INSTRUCTION("BCS", BCS, REL, 2), MOS6502_INSTRUCTION("LDA", LDA, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("LDY", LDY, ZPX, 4), MOS6502_INSTRUCTION("LDA", LDA, ZPX, 4), MOS6502_INSTRUCTION("LDX", LDX, ZPY, 4), MOS6502_INSTRUCTION("???", XXX, IMP, 4), MOS6502_INSTRUCTION("CLV", CLV, IMP, 2), MOS6502_INSTRUCTION("LDA", LDA, ABY, 4), MOS6502_INSTRUCTION("TSX", TSX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 4), MOS6502_INSTRUCTION("LDY", LDY, ABX, 4), MOS6502_INSTRUCTION("LDA", LDA, ABX, 4), MOS6502_INSTRUCTION("LDX", LDX, ABY, 4), MOS6502_INSTRUCTION("???", XXX, IMP, 4),
+    MOS6502_INSTRUCTION("CPY", CPY, IMM, 2), MOS6502_INSTRUCTION("CMP", CMP, IZX, 6), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("CPY", CPY, ZP0, 3), MOS6502_INSTRUCTION("CMP", CMP, ZP0, 3), MOS6502_INSTRUCTION("DEC", DEC, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("INY", INY, IMP, 2), MOS6502_INSTRUCTION("CMP", CMP, IMM, 2), MOS6502_INSTRUCTION("DEX", DEX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("CPY", CPY, ABS, 4), MOS6502_INSTRUCTION("CMP", CMP, ABS, 4), MOS6502_INSTRUCTION("DEC", DEC, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BNE", BNE, REL, 2), MOS6502_INSTRUCTION("CMP", CMP, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("CMP", CMP, ZPX, 4), MOS6502_INSTRUCTION("DEC", DEC, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("CLD", CLD, IMP, 2), MOS6502_INSTRUCTION("CMP", CMP, ABY, 4), MOS6502_INSTRUCTION("NOP", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("CMP", CMP, ABX, 4), MOS6502_INSTRUCTION("DEC", DEC, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+    MOS6502_INSTRUCTION("CPX", CPX, IMM, 2), MOS6502_INSTRUCTION("SBC", SBC, IZX, 6), MOS6502_INSTRUCTION("???", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("CPX", CPX, ZP0, 3), MOS6502_INSTRUCTION("SBC", SBC, ZP0, 3), MOS6502_INSTRUCTION("INC", INC, ZP0, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 5), MOS6502_INSTRUCTION("INX", INX, IMP, 2), MOS6502_INSTRUCTION("SBC", SBC, IMM, 2), MOS6502_INSTRUCTION("NOP", NOP, IMP, 2), MOS6502_INSTRUCTION("???", SBC, IMP, 2), MOS6502_INSTRUCTION("CPX", CPX, ABS, 4), MOS6502_INSTRUCTION("SBC", SBC, ABS, 4), MOS6502_INSTRUCTION("INC", INC, ABS, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6),
+    MOS6502_INSTRUCTION("BEQ", BEQ, REL, 2), MOS6502_INSTRUCTION("SBC", SBC, IZY, 5), MOS6502_INSTRUCTION("???", XXX, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 8), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("SBC", SBC, ZPX, 4), MOS6502_INSTRUCTION("INC", INC, ZPX, 6), MOS6502_INSTRUCTION("???", XXX, IMP, 6), MOS6502_INSTRUCTION("SED", SED, IMP, 2), MOS6502_INSTRUCTION("SBC", SBC, ABY, 4), MOS6502_INSTRUCTION("NOP", NOP, IMP, 2), MOS6502_INSTRUCTION("???", XXX, IMP, 7), MOS6502_INSTRUCTION("???", NOP, IMP, 4), MOS6502_INSTRUCTION("SBC", SBC, ABX, 4), MOS6502_INSTRUCTION("INC", INC, ABX, 7), MOS6502_INSTRUCTION("???", XXX, IMP, 7),
+}};
+#undef MOS6502_INSTRUCTION
+
+constexpr std::string_view MOS6502::getOperationName(const uint8_t& opcode) {
+    return operation_names[static_cast<size_t>(instruction_lookup_table[opcode].operation)];
+}
+
+constexpr std::string_view MOS6502::getAddressingModeName(const uint8_t& opcode) {
+    return addressing_mode_names[static_cast<size_t>(instruction_lookup_table[opcode].addressing_mode)];
+}
+
+constexpr uint8_t MOS6502::getInstructionLength(const uint8_t& opcode) {
+    switch (instruction_lookup_table[opcode].addressing_mode) {
+        case AddressingMode::IMP:
+            return 1;
+        case AddressingMode::ABS:
+        case AddressingMode::ABX:
+        case AddressingMode::ABY:
+        case AddressingMode::IND:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+static_assert(MOS6502::instruction_lookup_table[0xA9].operation == MOS6502::Operation::LDA);
+static_assert(MOS6502::getInstructionLength(0x6C) == 3);
+static_assert(MOS6502::operation_names.size() == static_cast<size_t>(MOS6502::Operation::XXX) + 1);
+static_assert(MOS6502::getOperationName(0xEB) == "SBC");
+
 #endif
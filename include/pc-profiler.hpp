@@ -0,0 +1,66 @@
+#ifndef _PC_PROFILER_HPP_
+#define _PC_PROFILER_HPP_
+// Standard Library Includes
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "cpu-observer.hpp"
+#include "memory-unit.hpp"
+
+// Attributes executed instructions and emulated cycles to the address of every instruction
+//   Exact mode counts every instruction in two flat 64K arrays
+//   Sampling mode only records the instruction running when every sample_interval-th cycle elapses,
+//   so most instructions cost one addition and one compare
+class PCProfiler : public CPUObserver {
+public:
+    /**
+    * @brief  Constructor for PCProfiler
+    * @param  sample_interval: Cycles between samples, 0 counts every instruction exactly
+    * @return None
+    */
+    PCProfiler(const uint64_t& sample_interval = 0);
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    /**
+    * @brief  Gets the instructions executed at an address, or the samples taken there in sampling mode
+    * @param  address: The instruction address
+    * @return Instructions or samples
+    */
+    uint64_t getInstructions(const uint16_t& address) const;
+
+    /**
+    * @brief  Gets the cycles spent at an address, estimated as samples times the interval in sampling mode
+    * @param  address: The instruction address
+    * @return Cycles spent
+    */
+    uint64_t getCycles(const uint16_t& address) const;
+
+    /**
+    * @brief  Zeroes every counter
+    * @param  None
+    * @return None
+    */
+    void reset();
+
+    /**
+    * @brief  Writes the addresses that took the most cycles, with their share of all cycles and their disassembly
+    * @param  out: The output stream
+    * @param  memory: Memory holding the program, used for disassembly
+    * @param  top: Number of addresses to list
+    * @return None
+    */
+    void writeReport(std::ostream& out, const MemoryUnit& memory, const size_t& top) const;
+
+private:
+    const uint64_t sample_interval_;
+    // Cycles seen so far and the cycle of the next sample
+    uint64_t total_cycles_;
+    uint64_t next_sample_cycle_;
+    std::vector<uint64_t> instruction_counts_;
+    std::vector<uint64_t> cycle_counts_;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef _PERF_COUNTERS_HPP_
+#define _PERF_COUNTERS_HPP_
+// Standard Library Includes
+#include <array>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+// Linux hardware performance counters of the calling thread, user space only
+//   Every counter is opened on its own, so a host or container that lacks some of them still reports the rest
+//   Counters that could not be opened read as std::nullopt
+class PerfCounters {
+public:
+    enum class Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1I_MISSES,
+        L1D_MISSES,
+    };
+    static constexpr size_t COUNTER_COUNT = 5;
+
+    // Usage: Maps Counter to the name used in reports and JSON
+    static constexpr std::array<std::string_view, COUNTER_COUNT> counter_names = {
+        "cycles", "instructions", "branch-misses", "L1i-misses", "L1d-misses",
+    };
+
+    /**
+    * @brief  Constructor for PerfCounters, opens every counter it can
+    * @param  None
+    * @return None
+    */
+    PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    /**
+    * @brief  Checks whether at least one counter could be opened
+    * @param  None
+    * @return True if any counter is available
+    */
+    bool available() const;
+
+    /**
+    * @brief  Gets why counters are missing
+    * @param  None
+    * @return Error of the first counter that failed to open, empty if all opened
+    */
+    const std::string& unavailableReason() const;
+
+    /**
+    * @brief  Resets and starts every open counter
+    * @param  None
+    * @return None
+    */
+    void start();
+
+    /**
+    * @brief  Stops every open counter
+    * @param  None
+    * @return None
+    */
+    void stop();
+
+    /**
+    * @brief  Reads a counter, scaled up if the kernel multiplexed it
+    * @param  counter: The counter to read
+    * @return Events counted between start and stop, std::nullopt if the counter is unavailable
+    */
+    std::optional<uint64_t> read(const Counter& counter) const;
+
+private:
+    std::array<int, COUNTER_COUNT> file_descriptors_;
+    std::string unavailable_reason_;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef _RESULT_CACHE_HPP_
+#define _RESULT_CACHE_HPP_
+// Standard Library Includes
+#include <string>
+#include <optional>
+#include <cstdint>
+// External Library Includes
+#include <nlohmann/json.hpp>
+// Project Includes
+#include "json-test-harness.hpp"
+// Using shorthand declarations
+using json = nlohmann::json;
+
+// Remembers per-opcode conformance results between runs
+//   A result is keyed by the hash of the opcode's test file, the build identity (compiler, flags, shared core
+//   sources, result-affecting harness options) and the fingerprints of the opcode's operation and addressing mode handlers
+class ResultCache {
+public:
+    struct FileHash {
+        uint64_t file_size;
+        int64_t file_mtime;
+        std::string hash;
+    };
+
+    struct Entry {
+        std::string key;
+        FileHash test_file;
+        bool passed;
+        JSONTestHarness::Summary summary;
+    };
+
+    /**
+    * @brief  Constructor for ResultCache, loads the cache file if it exists
+    * @param  file_path: Path to the cache file
+    * @return None
+    */
+    ResultCache(const std::string& file_path);
+
+    /**
+    * @brief  Hashes a test file, reusing the stored hash when its size and modification time are unchanged
+    * @param  opcode: The opcode the test file belongs to
+    * @param  test_file_path: Path to the test file
+    * @return Size, modification time and content hash of the file
+    */
+    FileHash hashTestFile(const uint8_t& opcode, const std::string& test_file_path) const;
+
+    /**
+    * @brief  Builds the cache key of an opcode
+    * @param  opcode: The opcode
+    * @param  test_file: Hash of the opcode's test file
+    * @param  options: Harness options of the run
+    * @return The cache key
+    */
+    static std::string opcodeKey(const uint8_t& opcode, const FileHash& test_file, const HarnessOptions& options);
+
+    /**
+    * @brief  Finds the cached result of an opcode
+    * @param  opcode: The opcode
+    * @param  key: Current cache key of the opcode
+    * @return The cached entry if its key matches, std::nullopt otherwise
+    */
+    std::optional<Entry> lookup(const uint8_t& opcode, const std::string& key) const;
+
+    /**
+    * @brief  Stores the result of an opcode
+    * @param  opcode: The opcode
+    * @param  entry: The result to store
+    * @return None
+    */
+    void store(const uint8_t& opcode, const Entry& entry);
+
+    /**
+    * @brief  Writes the cache back to its file
+    * @param  None
+    * @return True if successfully written, false otherwise
+    */
+    bool save() const;
+
+private:
+    std::string file_path_;
+    json entries_;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef _SHADOW_CALL_STACK_HPP_
+#define _SHADOW_CALL_STACK_HPP_
+// Standard Library Includes
+#include <vector>
+#include <cstdint>
+// Project Includes
+#include "cpu-observer.hpp"
+
+// Follows the emulated program's subroutine and interrupt handler calls from what a CPUObserver is told
+//   JSR, BRK, irq() and nmi() push a frame that remembers the stack pointer its return address lives above
+//   A frame is popped as soon as the stack pointer rises to that value, whatever raised it, so RTS, RTI,
+//   PLA/PLA aborts and TXS unwinds all keep the shadow stack in step with the real one
+//   A JMP into another function that was entered before replaces the current frame, as a tail call
+class ShadowCallStack {
+public:
+    enum class FrameType : uint8_t {
+        SUBROUTINE,
+        BRK,
+        IRQ,
+        NMI,
+    };
+
+    struct Frame {
+        uint16_t function;
+        // Stack pointer once the frame's return address is popped
+        uint8_t return_stack_ptr;
+        FrameType type;
+    };
+
+    // Told of every change to the shadow stack as it happens, so it can keep its own data per frame
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+        * @brief  Called after a frame was pushed
+        * @param  frame: The new frame
+        * @return None
+        */
+        virtual void onCall(const Frame& frame) = 0;
+
+        /**
+        * @brief  Called after a frame was popped
+        * @param  frame: The popped frame
+        * @return None
+        */
+        virtual void onReturn(const Frame& frame) = 0;
+
+        /**
+        * @brief  Called after the top frame was replaced by a tail call
+        * @param  previous: The frame before the jump
+        * @param  frame: The frame of the function jumped to, it returns where the previous one would have
+        * @return None
+        */
+        virtual void onTailCall(const Frame& previous, const Frame& frame) = 0;
+    };
+
+    /**
+    * @brief  Constructor for ShadowCallStack
+    * @param  listener: Told of every change, must outlive the stack
+    * @return None
+    */
+    ShadowCallStack(Listener& listener);
+
+    /**
+    * @brief  Follows an instruction that just executed
+    * @param  cpu: The CPU, already in the state after the instruction
+    * @param  opcode: The executed opcode
+    * @return None
+    */
+    void onInstruction(const MOS6502& cpu, const uint8_t& opcode);
+
+    /**
+    * @brief  Pushes the frame of an interrupt handler
+    * @param  cpu: The CPU, already at the first instruction of the handler
+    * @param  interrupt: Whether irq() or nmi() raised it
+    * @return None
+    */
+    void onInterrupt(const MOS6502& cpu, const CPUObserver::Interrupt& interrupt);
+
+    /**
+    * @brief  Marks an address as a function entry without calling it, so a JMP to it is a tail call
+    * @param  address: The function's address
+    * @return None
+    */
+    void addFunctionEntry(const uint16_t& address);
+
+    /**
+    * @brief  Pops every frame, innermost first
+    * @param  None
+    * @return None
+    */
+    void unwind();
+
+    /**
+    * @brief  Gets the frames, outermost first
+    * @param  None
+    * @return The frames
+    */
+    const std::vector<Frame>& getFrames() const;
+
+private:
+    Listener& listener_;
+    std::vector<Frame> frames_;
+    std::vector<bool> function_entries_;
+
+    /**
+    * @brief  Pushes a frame and marks its function as an entry
+    * @param  frame: The new frame
+    * @return None
+    */
+    void push(const Frame& frame);
+
+    /**
+    * @brief  Pops the top frame
+    * @param  None
+    * @return None
+    */
+    void pop();
+};
+
+#endif
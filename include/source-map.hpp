@@ -0,0 +1,40 @@
+#ifndef _SOURCE_MAP_HPP_
+#define _SOURCE_MAP_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Maps assembler source lines to the addresses they assembled to, loaded from a ca65/ld65 debug file (ld65 --dbgfile)
+class SourceMap {
+public:
+    struct AddressRange {
+        uint16_t start;
+        uint32_t size;
+    };
+
+    struct SourceLine {
+        std::string file;
+        uint32_t line;
+        std::vector<AddressRange> ranges;
+    };
+
+    /**
+    * @brief  Loads the line, span, segment and file records of a debug file
+    * @param  file_path: Path to the debug file
+    * @return Number of source lines that map to addresses
+    */
+    size_t loadFile(const std::string& file_path);
+
+    /**
+    * @brief  Gets every source line that assembled to at least one byte
+    * @param  None
+    * @return Source lines in the order of the debug file
+    */
+    const std::vector<SourceLine>& getLines() const;
+
+private:
+    std::vector<SourceLine> lines_;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef _STACK_ANALYZER_HPP_
+#define _STACK_ANALYZER_HPP_
+// Standard Library Includes
+#include <map>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "cpu-observer.hpp"
+#include "symbol-table.hpp"
+#include "shadow-call-stack.hpp"
+
+// Tracks how deep the program drives the stack in page 1
+//   Records the deepest stack pointer, every push that wraps from $00 to $FF and every pull that wraps from $FF to $00,
+//   and the deepest stack each subroutine and interrupt handler needed, including what it called
+class StackAnalyzer : public CPUObserver, private ShadowCallStack::Listener {
+public:
+    struct Wraparound {
+        // True for a push below $0100, false for a pull above $01FF
+        bool overflow;
+        uint16_t instruction_address;
+        uint64_t cycle;
+    };
+
+    struct FunctionStackUsage {
+        uint16_t address;
+        uint64_t calls;
+        // Most bytes below the caller's stack pointer used by one call, return address included
+        uint32_t max_bytes;
+    };
+
+    /**
+    * @brief  Constructor for StackAnalyzer
+    * @param  cpu: The CPU the analyzer is attached to, gives the starting stack pointer and cycle
+    * @param  symbols: Names of functions, must outlive the analyzer
+    * @return None
+    */
+    StackAnalyzer(const MOS6502& cpu, const SymbolTable& symbols);
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) override;
+
+    /**
+    * @brief  Gets the stack pointer at the worst-case depth, the lowest one below the stack pointer it was measured from
+    * @param  None
+    * @return The deepest stack pointer
+    */
+    uint8_t getMinimumStackPtr() const;
+
+    /**
+    * @brief  Gets every wraparound, the first ones only if there were many
+    * @param  None
+    * @return Wraparounds in the order they happened
+    */
+    const std::vector<Wraparound>& getWraparounds() const;
+
+    /**
+    * @brief  Gets the stack usage of every subroutine and interrupt handler that was entered
+    * @param  None
+    * @return Usage per function, deepest first
+    */
+    std::vector<FunctionStackUsage> getFunctionStackUsage() const;
+
+    /**
+    * @brief  Writes the worst-case depth, the wraparounds and the deepest functions
+    * @param  out: The output stream
+    * @param  top: Number of wraparounds and functions to list
+    * @return None
+    */
+    void writeReport(std::ostream& out, const size_t& top) const;
+
+private:
+    const SymbolTable& symbols_;
+    // Depth is measured from the highest stack pointer since the last TXS,
+    //   reset leaves it at $FD but most programs move it to $FF first
+    uint8_t base_stack_ptr_;
+    uint8_t stack_ptr_;
+    uint64_t cycle_;
+    uint8_t min_stack_ptr_;
+    uint8_t min_stack_ptr_base_;
+    uint16_t min_stack_ptr_address_;
+    uint64_t min_stack_ptr_cycle_;
+    std::vector<Wraparound> wraparounds_;
+    uint64_t overflows_;
+    uint64_t underflows_;
+    ShadowCallStack shadow_call_stack_;
+    // Lowest stack pointer while each shadow stack frame or anything it called ran, outermost first
+    std::vector<uint8_t> frame_min_stack_ptrs_;
+    std::map<uint16_t, FunctionStackUsage> function_usage_;
+
+    /**
+    * @brief  Records a new stack pointer and any wraparound that led to it
+    * @param  stack_ptr: Stack pointer after the instruction or interrupt
+    * @param  pushed: Whether the instruction or interrupt only pushed
+    * @param  pulled: Whether the instruction only pulled
+    * @param  transferred: Whether the instruction was a TXS, which starts measuring from the new stack pointer
+    * @param  instruction_address: Address of the instruction
+    * @return None
+    */
+    void updateStackPtr(const uint8_t& stack_ptr, const bool& pushed, const bool& pulled, const bool& transferred, const uint16_t& instruction_address);
+
+    void onCall(const ShadowCallStack::Frame& frame) override;
+
+    // Records the frame's usage and passes its lowest stack pointer to its caller
+    void onReturn(const ShadowCallStack::Frame& frame) override;
+
+    void onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) override;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _SYMBOL_TABLE_HPP_
+#define _SYMBOL_TABLE_HPP_
+// Standard Library Includes
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+// Names of program addresses, loaded from assembler and emulator symbol files
+//   Supported formats: ca65/ld65 debug files (ld65 --dbgfile) and VICE label files (al C:1234 .label)
+class SymbolTable {
+public:
+    /**
+    * @brief  Loads the labels of a symbol file into the table, detecting its format from its contents
+    *         Addresses that already have a name keep it
+    * @param  file_path: Path to the symbol file
+    * @return Number of labels loaded
+    */
+    size_t loadFile(const std::string& file_path);
+
+    /**
+    * @brief  Names an address unless it already has a name
+    * @param  address: The address
+    * @param  name: The name
+    * @return None
+    */
+    void add(const uint16_t& address, const std::string& name);
+
+    /**
+    * @brief  Gets the name of an address
+    * @param  address: The address
+    * @return The label, or the address formatted as $XXXX when it has none
+    */
+    std::string name(const uint16_t& address) const;
+
+    /**
+    * @brief  Gets the number of named addresses
+    * @param  None
+    * @return Number of named addresses
+    */
+    size_t size() const;
+
+private:
+    std::unordered_map<uint16_t, std::string> names_;
+};
+
+#endif
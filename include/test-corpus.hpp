@@ -0,0 +1,173 @@
+#ifndef _TEST_CORPUS_HPP_
+#define _TEST_CORPUS_HPP_
+// Standard Library Includes
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+// External Library Includes
+#include <nlohmann/json.hpp>
+// Using shorthand declarations
+using json = nlohmann::json;
+
+#define TEST_CORPUS_MAGIC "MOS6502C"
+#define TEST_CORPUS_VERSION 1
+
+// Compact binary form of a SingleStepTests JSON file
+//   Layout: Header | TestRecord[test_count] | RAMEntry[ram_entry_count] | CycleEntry[cycle_entry_count] | names
+//   Every section is naturally aligned so the whole file can be used in place after mmap (little-endian hosts)
+class TestCorpus {
+public:
+    struct State {
+        uint16_t program_counter;
+        uint8_t stack_ptr;
+        uint8_t accumulator;
+        uint8_t x_reg;
+        uint8_t y_reg;
+        uint8_t processor_status;
+        uint8_t padding;
+    };
+
+    struct RAMEntry {
+        uint16_t address;
+        uint8_t value;
+        uint8_t padding;
+    };
+
+    enum class BusActivity : uint8_t {
+        READ,
+        WRITE,
+    };
+
+    struct CycleEntry {
+        uint16_t address;
+        uint8_t value;
+        BusActivity activity;
+    };
+
+    struct TestRecord {
+        State initial;
+        State final;
+        // Offsets are indices into the RAM, cycle and name sections
+        uint32_t name_offset;
+        uint32_t initial_ram_offset;
+        uint32_t final_ram_offset;
+        uint32_t cycles_offset;
+        uint16_t name_length;
+        uint16_t initial_ram_count;
+        uint16_t final_ram_count;
+        uint16_t cycles_count;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t test_count;
+        uint32_t ram_entry_count;
+        uint32_t cycle_entry_count;
+        uint32_t name_bytes;
+        uint32_t reserved;
+    };
+
+    /**
+    * @brief  Builds an in-memory corpus from parsed SingleStepTests JSON
+    * @param  tests: JSON array of test cases
+    * @return The corpus
+    */
+    static TestCorpus fromJSON(const json& tests);
+
+    /**
+    * @brief  Maps a binary corpus file into memory
+    * @param  file_path: Path to the corpus file
+    * @return The corpus
+    */
+    static TestCorpus fromFile(const std::string& file_path);
+
+    /**
+    * @brief  Checks whether a file starts with the corpus magic
+    * @param  file_path: Path to the file
+    * @return True if the file is a binary corpus, false otherwise
+    */
+    static bool isCorpusFile(const std::string& file_path);
+
+    TestCorpus(TestCorpus&& other) noexcept;
+    TestCorpus& operator=(TestCorpus&& other) noexcept;
+    TestCorpus(const TestCorpus&) = delete;
+    TestCorpus& operator=(const TestCorpus&) = delete;
+    ~TestCorpus();
+
+    /**
+    * @brief  Writes the corpus to a file
+    * @param  file_path: Path of the output file
+    * @return None
+    */
+    void writeToFile(const std::string& file_path) const;
+
+    /**
+    * @brief  Gets the number of test cases
+    * @param  None
+    * @return Number of test cases
+    */
+    uint32_t size() const;
+
+    /**
+    * @brief  Gets the test record at index
+    * @param  index: Index of the test case
+    * @return The test record
+    */
+    const TestRecord& record(const uint32_t& index) const;
+
+    /**
+    * @brief  Gets the name of the test case at index
+    * @param  index: Index of the test case
+    * @return Name of the test case
+    */
+    std::string_view name(const uint32_t& index) const;
+
+    /**
+    * @brief  Gets the initial RAM of the test case at index
+    * @param  index: Index of the test case
+    * @return Address value pairs to write before running the test
+    */
+    std::span<const RAMEntry> initialRAM(const uint32_t& index) const;
+
+    /**
+    * @brief  Gets the expected final RAM of the test case at index
+    * @param  index: Index of the test case
+    * @return Address value pairs expected after running the test
+    */
+    std::span<const RAMEntry> finalRAM(const uint32_t& index) const;
+
+    /**
+    * @brief  Gets the expected bus activity of the test case at index
+    * @param  index: Index of the test case
+    * @return One entry per cycle of the instruction
+    */
+    std::span<const CycleEntry> cycles(const uint32_t& index) const;
+
+private:
+    TestCorpus() = default;
+
+    /**
+    * @brief  Points the section pointers into data_ after validating the layout
+    * @param  None
+    * @return None
+    */
+    void bindSections();
+
+    // Owned buffer when built from JSON, empty when memory mapped
+    std::vector<uint8_t> owned_buffer_;
+    const uint8_t* data_ = nullptr;
+    size_t data_size_ = 0;
+    bool memory_mapped_ = false;
+
+    const Header* header_ = nullptr;
+    const TestRecord* records_ = nullptr;
+    const RAMEntry* ram_entries_ = nullptr;
+    const CycleEntry* cycle_entries_ = nullptr;
+    const char* names_ = nullptr;
+};
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef _TRACE_EVENT_WRITER_HPP_
+#define _TRACE_EVENT_WRITER_HPP_
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+// Project Includes
+#include "cpu-observer.hpp"
+#include "bus-observer.hpp"
+#include "symbol-table.hpp"
+#include "shadow-call-stack.hpp"
+
+// Streams Chrome trace events (chrome://tracing, ui.perfetto.dev) on the emulated cycle timeline
+//   Timestamps are emulated cycles converted with MOS6502_CLOCK_PERIOD
+//   Every ShadowCallStack frame, a subroutine or an IRQ, NMI or BRK handler, is a nested span on the CPU track;
+//   accesses to device register ranges are instant events on the device track and transfers reported with onDMA
+//   are spans on the DMA track
+class TraceEventWriter : public CPUObserver, public BusObserver, private ShadowCallStack::Listener {
+public:
+    /**
+    * @brief  Constructor for TraceEventWriter, writes the start of the trace
+    * @param  out: Where to stream the trace, must outlive the writer
+    * @param  cpu: The CPU the writer is attached to, gives the starting cycle
+    * @param  symbols: Names of functions, must outlive the writer
+    * @return None
+    */
+    TraceEventWriter(std::ostream& out, const MOS6502& cpu, const SymbolTable& symbols);
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) override;
+
+    void onRead(const uint16_t& address, const uint8_t& data) override;
+
+    void onWrite(const uint16_t& address, const uint8_t& data) override;
+
+    /**
+    * @brief  Traces every read and write of an address range as a device register access
+    * @param  name: Name of the device
+    * @param  start: First register address
+    * @param  end: Last register address
+    * @return None
+    */
+    void addDevice(const std::string& name, const uint16_t& start, const uint16_t& end);
+
+    /**
+    * @brief  Traces a DMA transfer starting at the current cycle, for devices that copy memory on their own
+    * @param  name: Name of the transfer
+    * @param  source: First address copied from
+    * @param  destination: First address copied to
+    * @param  length: Number of bytes copied
+    * @param  cycles: Cycles the transfer takes
+    * @return None
+    */
+    void onDMA(const std::string& name, const uint16_t& source, const uint16_t& destination, const uint32_t& length, const uint64_t& cycles);
+
+    /**
+    * @brief  Ends every open span at the current cycle and writes the end of the trace, nothing is written after it
+    * @param  None
+    * @return None
+    */
+    void finish();
+
+private:
+    struct Device {
+        std::string name;
+        uint16_t start;
+        uint16_t end;
+    };
+
+    std::ostream& out_;
+    const SymbolTable& symbols_;
+    // Cycle the current instruction started at, bus accesses are traced at it
+    uint64_t cycle_;
+    // Cycle the spans begun by the current instruction or interrupt start at
+    uint64_t span_cycle_;
+    std::vector<Device> devices_;
+    ShadowCallStack shadow_call_stack_;
+    bool first_event_;
+    bool finished_;
+
+    /**
+    * @brief  Writes one event, preceded by the separator from the previous one
+    * @param  event: The event's JSON object
+    * @return None
+    */
+    void writeEvent(const std::string& event);
+
+    void onCall(const ShadowCallStack::Frame& frame) override;
+
+    void onReturn(const ShadowCallStack::Frame& frame) override;
+
+    void onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) override;
+
+    /**
+    * @brief  Begins a span on the CPU track
+    * @param  frame: The frame the span covers
+    * @param  cycle: Cycle the span begins at
+    * @return None
+    */
+    void beginSpan(const ShadowCallStack::Frame& frame, const uint64_t& cycle);
+
+    /**
+    * @brief  Ends the innermost span on the CPU track at the current cycle
+    * @param  None
+    * @return None
+    */
+    void endSpan();
+
+    /**
+    * @brief  Traces an access if it falls in a device register range
+    * @param  access: read or write
+    * @param  address: The address accessed
+    * @param  data: The data read or written
+    * @return None
+    */
+    void traceDeviceAccess(const std::string& access, const uint16_t& address, const uint8_t& data);
+};
+
+#endif
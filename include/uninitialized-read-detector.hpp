@@ -0,0 +1,74 @@
+#ifndef _UNINITIALIZED_READ_DETECTOR_HPP_
+#define _UNINITIALIZED_READ_DETECTOR_HPP_
+// Standard Library Includes
+#include <map>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+// Project Includes
+#include "bus-observer.hpp"
+#include "cpu-observer.hpp"
+
+// Shadow memory with one bit per address that is set once the address holds a defined value
+//   MemoryUnit zero-fills, so a read of RAM never written since reset silently returns 0; this reports such reads
+//   with the address and cycle of the instruction that made them
+//   Attach it to the BUS and to the CPU, a BUS without observers pays nothing
+class UninitializedReadDetector : public BusObserver, public CPUObserver {
+public:
+    struct UninitializedRead {
+        uint16_t instruction_address;
+        uint16_t address;
+        // Cycle the first such read's instruction started at
+        uint64_t first_cycle;
+        uint64_t count;
+    };
+
+    /**
+    * @brief  Constructor for UninitializedReadDetector, every address starts uninitialized
+    * @param  cpu: The CPU the detector is attached to, gives the address and cycle of the first instruction
+    * @return None
+    */
+    UninitializedReadDetector(const MOS6502& cpu);
+
+    void onRead(const uint16_t& address, const uint8_t& data) override;
+
+    void onWrite(const uint16_t& address, const uint8_t& data) override;
+
+    void onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) override;
+
+    void onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) override;
+
+    /**
+    * @brief  Marks addresses as holding defined values, e.g. ROM or a loaded program
+    * @param  start_address: First address
+    * @param  size: Number of addresses
+    * @return None
+    */
+    void markInitialized(const uint16_t& start_address, const uint32_t& size);
+
+    /**
+    * @brief  Gets every distinct instruction and address pair that read uninitialized memory
+    * @param  None
+    * @return The reads, in order of their first occurrence
+    */
+    std::vector<UninitializedRead> getUninitializedReads() const;
+
+    /**
+    * @brief  Writes every distinct uninitialized read, in order of its first occurrence
+    * @param  out: The output stream
+    * @return None
+    */
+    void writeReport(std::ostream& out) const;
+
+private:
+    std::vector<bool> initialized_;
+    // Address and start cycle of the instruction whose accesses the BUS reports next
+    uint16_t instruction_address_;
+    uint64_t instruction_cycle_;
+    // Keyed by instruction and read address
+    std::map<std::pair<uint16_t, uint16_t>, UninitializedRead> uninitialized_reads_;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#!/bin/sh
+# Generates a header with a fingerprint of every instruction and addressing mode handler in src/mos6502.cpp
+#   Usage: handler-fingerprints.sh "<compiler and flags>" src/mos6502.cpp [other core sources...]
+#   A handler fingerprint only changes when that handler's body changes. Everything else in the core
+#   sources (the table, runInstruction, the bus, the harness...) goes into MOS6502_CORE_FINGERPRINT.
+set -e
+
+build_flags=$(printf '%s' "$1" | sed 's/\\/\\\\/g; s/"/\\"/g')
+shift
+cpu_source="$1"
+
+handler_start='^(MOS6502::CycleType|uint8_t) MOS6502::[A-Z0-9][A-Z0-9][A-Z0-9]\(MOS6502& cpu\) \{'
+
+crc() {
+    cksum | cut -d ' ' -f 1
+}
+
+core_fingerprint=$({
+    awk -v start="$handler_start" '$0 ~ start { skip = 1 } !skip { print } skip && /^}/ { skip = 0 }' "$cpu_source"
+    shift
+    cat "$@"
+} | crc)
+
+echo "// Generated by scripts/handler-fingerprints.sh, do not edit"
+echo "#ifndef _HANDLER_FINGERPRINTS_HPP_"
+echo "#define _HANDLER_FINGERPRINTS_HPP_"
+echo "#include <cstdint>"
+echo "#include <string_view>"
+echo
+echo "#define MOS6502_BUILD_FLAGS \"$build_flags\""
+echo "#define MOS6502_CORE_FINGERPRINT ${core_fingerprint}u"
+echo
+echo "struct HandlerFingerprint {"
+echo "    std::string_view name;"
+echo "    uint32_t fingerprint;"
+echo "};"
+echo
+echo "static constexpr HandlerFingerprint handler_fingerprints[] = {"
+for handler in $(awk -v start="$handler_start" '$0 ~ start { sub(/\(.*/, ""); sub(/.*::/, ""); print }' "$cpu_source"); do
+    fingerprint=$(awk -v start="^(MOS6502::CycleType|uint8_t) MOS6502::$handler\\\\(" '$0 ~ start { inside = 1 } inside { print } inside && /^}/ { inside = 0 }' "$cpu_source" | crc)
+    echo "    {\"$handler\", ${fingerprint}u},"
+done
+echo "};"
+echo
+echo "#endif"
@@ -0,0 +1,167 @@
+#include "benchmark-comparison.hpp"
+// Standard Library Includes
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <algorithm>
+
+static double sample_mean(const std::vector<double>& sample) {
+    double total = 0;
+    for (const double& value : sample) {
+        total += value;
+    }
+    return total / sample.size();
+}
+
+static double sample_variance(const std::vector<double>& sample, const double& mean) {
+    if (sample.size() < 2) return 0;
+    double total = 0;
+    for (const double& value : sample) {
+        total += (value - mean) * (value - mean);
+    }
+    return total / (sample.size() - 1);
+}
+
+// Continued fraction of the regularized incomplete beta function, evaluated with the modified Lentz method
+static double incomplete_beta_fraction(const double& a, const double& b, const double& x) {
+    const double tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    d = 1 / (std::fabs(d) < tiny ? tiny : d);
+    double fraction = d;
+    for (int m = 1; m <= 300; m++) {
+        for (const double& numerator : {m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                                        -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))}) {
+            d = 1 + numerator * d;
+            d = 1 / (std::fabs(d) < tiny ? tiny : d);
+            c = 1 + numerator / c;
+            c = std::fabs(c) < tiny ? tiny : c;
+            fraction *= c * d;
+        }
+        if (std::fabs(c * d - 1) < 1e-12) break;
+    }
+    return fraction;
+}
+
+static double regularized_incomplete_beta(const double& a, const double& b, const double& x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1 - x));
+    // The continued fraction converges quickly only on this side of the mean
+    if (x < (a + 1) / (a + b + 2)) {
+        return front * incomplete_beta_fraction(a, b, x) / a;
+    }
+    return 1 - front * incomplete_beta_fraction(b, a, 1 - x) / b;
+}
+
+WelchTest welchTTest(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+    const double baseline_mean = sample_mean(baseline);
+    const double candidate_mean = sample_mean(candidate);
+    const double baseline_error = sample_variance(baseline, baseline_mean) / baseline.size();
+    const double candidate_error = sample_variance(candidate, candidate_mean) / candidate.size();
+    const double standard_error = std::sqrt(baseline_error + candidate_error);
+
+    if (standard_error == 0) {
+        // No spread at all, any difference is certain
+        const bool same_mean = baseline_mean == candidate_mean;
+        return WelchTest{same_mean ? 0 : std::numeric_limits<double>::infinity(), 0, same_mean ? 1.0 : 0.0};
+    }
+
+    const double t_statistic = (candidate_mean - baseline_mean) / standard_error;
+    const double degrees_of_freedom = (baseline_error + candidate_error) * (baseline_error + candidate_error) /
+        (baseline_error * baseline_error / std::max<double>(1, baseline.size() - 1) + candidate_error * candidate_error / std::max<double>(1, candidate.size() - 1));
+    const double p_value = regularized_incomplete_beta(degrees_of_freedom / 2, 0.5, degrees_of_freedom / (degrees_of_freedom + t_statistic * t_statistic));
+    return WelchTest{t_statistic, degrees_of_freedom, p_value};
+}
+
+static std::map<std::string, std::vector<double>> ns_per_instruction_samples(const json& result_file) {
+    std::map<std::string, std::vector<double>> samples;
+    for (const auto& result : result_file["results"]) {
+        const double instructions = result["instructions"].get<double>();
+        std::vector<double>& workload_samples = samples[result["name"].get<std::string>()];
+        for (const auto& seconds : result["seconds"]) {
+            workload_samples.push_back(seconds.get<double>() / instructions * 1e9);
+        }
+    }
+    return samples;
+}
+
+BenchmarkComparison::BenchmarkComparison(const json& baseline, const json& candidate, const double& threshold_percent, const double& alpha):
+    baseline_metadata_(baseline.value("metadata", json::object())), candidate_metadata_(candidate.value("metadata", json::object())),
+    threshold_percent_{threshold_percent}, alpha_{alpha} {
+    const std::map<std::string, std::vector<double>> baseline_samples = ns_per_instruction_samples(baseline);
+    const std::map<std::string, std::vector<double>> candidate_samples = ns_per_instruction_samples(candidate);
+
+    // Keep the baseline order, workloads only in the candidate are listed after it
+    std::vector<std::string> names;
+    for (const auto& result : baseline["results"]) {
+        names.push_back(result["name"].get<std::string>());
+    }
+    for (const auto& result : candidate["results"]) {
+        if (!baseline_samples.contains(result["name"].get<std::string>())) {
+            names.push_back(result["name"].get<std::string>());
+        }
+    }
+
+    for (const std::string& name : names) {
+        WorkloadComparison comparison{name, 0, 0, 0, WelchTest{0, 0, 1}, Verdict::MISSING};
+        const auto baseline_workload = baseline_samples.find(name);
+        const auto candidate_workload = candidate_samples.find(name);
+        if (baseline_workload == baseline_samples.end() || candidate_workload == candidate_samples.end() ||
+            baseline_workload->second.empty() || candidate_workload->second.empty()) {
+            comparisons_.push_back(comparison);
+            continue;
+        }
+
+        comparison.baseline_ns = sample_mean(baseline_workload->second);
+        comparison.candidate_ns = sample_mean(candidate_workload->second);
+        comparison.delta_percent = (comparison.candidate_ns - comparison.baseline_ns) / comparison.baseline_ns * 100;
+        comparison.test = welchTTest(baseline_workload->second, candidate_workload->second);
+        comparison.verdict = Verdict::UNCHANGED;
+        if (comparison.test.p_value < alpha_ && std::fabs(comparison.delta_percent) > threshold_percent_) {
+            comparison.verdict = comparison.delta_percent > 0 ? Verdict::REGRESSED : Verdict::IMPROVED;
+        }
+        comparisons_.push_back(comparison);
+    }
+}
+
+bool BenchmarkComparison::hasRegression() const {
+    return std::any_of(comparisons_.begin(), comparisons_.end(), [](const WorkloadComparison& comparison) {
+        return comparison.verdict == Verdict::REGRESSED;
+    });
+}
+
+void BenchmarkComparison::writeReport(std::ostream& out) const {
+    // Numbers from different hosts or builds are still compared, but the difference is worth knowing
+    for (const char* section : {"host", "build", "options"}) {
+        const json baseline_section = baseline_metadata_.value(section, json::object());
+        const json candidate_section = candidate_metadata_.value(section, json::object());
+        for (const auto& [key, value] : baseline_section.items()) {
+            if (key == "timestamp" || candidate_section.value(key, json()) == value) continue;
+            out << "Note: " << section << "." << key << " differs: " << value << " vs " << candidate_section.value(key, json()) << "\n";
+        }
+    }
+
+    out << std::left << std::setw(28) << "Workload" << std::right << std::setw(12) << "base ns" << std::setw(12) << "new ns";
+    out << std::setw(10) << "delta" << std::setw(10) << "p-value" << "  Verdict\n";
+    uint32_t regressions = 0;
+    uint32_t improvements = 0;
+    for (const WorkloadComparison& comparison : comparisons_) {
+        out << std::left << std::setw(28) << comparison.name << std::right;
+        if (comparison.verdict == Verdict::MISSING) {
+            out << "  only in one file\n";
+            continue;
+        }
+        out << std::fixed << std::setprecision(2) << std::setw(12) << comparison.baseline_ns << std::setw(12) << comparison.candidate_ns;
+        out << std::showpos << std::setw(9) << comparison.delta_percent << "%" << std::noshowpos;
+        out << std::setprecision(4) << std::setw(10) << comparison.test.p_value;
+        switch (comparison.verdict) {
+            case Verdict::REGRESSED: out << "  REGRESSED\n"; regressions++; break;
+            case Verdict::IMPROVED: out << "  improved\n"; improvements++; break;
+            default: out << "\n"; break;
+        }
+    }
+    out << std::defaultfloat;
+    out << regressions << " regressed, " << improvements << " improved (threshold " << threshold_percent_ << "%, alpha " << alpha_ << ")\n";
+}
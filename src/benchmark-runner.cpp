@@ -0,0 +1,384 @@
+#include "benchmark-runner.hpp"
+// Standard Library Includes
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <sstream>
+#include <map>
+#include <fstream>
+#include <thread>
+#include <ctime>
+#include <stdexcept>
+#include <optional>
+#include <memory>
+#include <latch>
+// POSIX Includes
+#include <spawn.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// Project Includes
+#include "bus.hpp"
+#include "mos6502.hpp"
+#include "perf-counters.hpp"
+#include "handler-fingerprints.hpp"
+
+static std::string host_cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.starts_with("model name")) {
+            return line.substr(line.find(':') + 2);
+        }
+    }
+    return "unknown";
+}
+
+static json host_metadata() {
+    char hostname[256] = {};
+    gethostname(hostname, sizeof(hostname) - 1);
+    struct utsname system_name;
+    const bool has_system_name = uname(&system_name) == 0;
+
+    char timestamp[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    return json{
+        {"hostname", hostname},
+        {"cpu", host_cpu_model()},
+        {"hardware_threads", std::thread::hardware_concurrency()},
+        {"os", has_system_name ? std::string(system_name.sysname) + " " + system_name.release + " " + system_name.machine : "unknown"},
+        {"timestamp", timestamp},
+    };
+}
+
+// Instructions an instance runs before its thread switches to the next instance
+#define SCALING_SLICE_INSTRUCTIONS 1000
+
+// One emulator instance of a scaling run, BUS holds references into the CPU and RAM so it is never moved
+struct ScalingInstance {
+    MOS6502 cpu;
+    MemoryUnit ram;
+    BUS bus;
+
+    ScalingInstance(const MemoryUnit& image): ram(image), bus(cpu, ram) {}
+};
+
+double BenchmarkResult::medianSeconds() const {
+    if (seconds.empty()) return 0;
+    std::vector<double> sorted_seconds = seconds;
+    std::sort(sorted_seconds.begin(), sorted_seconds.end());
+    const size_t middle = sorted_seconds.size() / 2;
+    return sorted_seconds.size() % 2 ? sorted_seconds[middle] : (sorted_seconds[middle - 1] + sorted_seconds[middle]) / 2;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options): options_{options} {}
+
+BenchmarkResult BenchmarkRunner::run(const BenchmarkWorkload& workload) const {
+    const MemoryUnit image = buildWorkloadImage(workload);
+    BenchmarkResult result{workload.name, 0, 0, {}, {}, {}};
+    for (uint32_t i = 0; i < options_.warmup_repetitions; i++) {
+        runOnce(workload, image, result);
+    }
+    result.counters.clear();
+    for (uint32_t i = 0; i < options_.repetitions; i++) {
+        result.seconds.push_back(runOnce(workload, image, result));
+    }
+    return result;
+}
+
+double BenchmarkRunner::runOnce(const BenchmarkWorkload& workload, const MemoryUnit& image, BenchmarkResult& result) const {
+    MOS6502 cpu;
+    MemoryUnit ram(image);
+    BUS bus(cpu, ram);
+    const uint64_t start_cycles = cpu.getCyclesElapsed();
+    // Opened per repetition so the counters follow whichever thread runs the workload
+    std::optional<PerfCounters> perf_counters;
+    if (options_.hardware_counters) {
+        perf_counters.emplace();
+        perf_counters->start();
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (workload.irq_interval == 0) {
+        for (uint64_t i = 0; i < options_.instructions; i++) {
+            cpu.runInstruction();
+        }
+    }
+    else {
+        for (uint64_t i = 1; i <= options_.instructions; i++) {
+            cpu.runInstruction();
+            if (i % workload.irq_interval == 0) cpu.irq();
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if (perf_counters) {
+        perf_counters->stop();
+        result.counters_unavailable = perf_counters->unavailableReason();
+        for (size_t i = 0; i < PerfCounters::COUNTER_COUNT; i++) {
+            const std::optional<uint64_t> count = perf_counters->read(static_cast<PerfCounters::Counter>(i));
+            if (count) result.counters[std::string(PerfCounters::counter_names[i])] += *count;
+        }
+    }
+    result.instructions = options_.instructions;
+    result.cycles = cpu.getCyclesElapsed() - start_cycles;
+    return std::chrono::duration<double>(end - start).count();
+}
+
+BenchmarkResult BenchmarkRunner::runScaling(const BenchmarkWorkload& workload, const uint32_t& threads, const uint32_t& instances_per_thread, const MemoryLayout& layout) const {
+    const MemoryUnit image = buildWorkloadImage(workload);
+    const std::string layout_name = layout == MemoryLayout::SHARED_ROM ? "shared-rom" : "private-ram";
+    BenchmarkResult result{workload.name + " " + layout_name + " " + std::to_string(threads) + "x" + std::to_string(instances_per_thread), 0, 0, {}, {}, {}};
+    result.threads = threads;
+    result.instances_per_thread = instances_per_thread;
+    for (uint32_t i = 0; i < options_.warmup_repetitions + options_.repetitions; i++) {
+        const double seconds = runScalingOnce(workload, image, layout, result);
+        if (i >= options_.warmup_repetitions) {
+            result.seconds.push_back(seconds);
+        }
+    }
+    return result;
+}
+
+double BenchmarkRunner::runScalingOnce(const BenchmarkWorkload& workload, const MemoryUnit& image, const MemoryLayout& layout, BenchmarkResult& result) const {
+    std::latch ready(result.threads + 1);
+    std::latch start(1);
+    std::vector<uint64_t> thread_cycles(result.threads);
+    std::vector<std::thread> workers;
+    for (uint32_t thread_index = 0; thread_index < result.threads; thread_index++) {
+        workers.emplace_back([&, thread_index]() {
+            // Created on the thread that runs them, so their memory is first touched by it
+            std::vector<std::unique_ptr<ScalingInstance>> instances;
+            for (uint32_t i = 0; i < result.instances_per_thread; i++) {
+                instances.push_back(std::make_unique<ScalingInstance>(image));
+                if (layout == MemoryLayout::SHARED_ROM) {
+                    instances.back()->bus.mapROM(&image, WORKLOAD_LOAD_ADDRESS, workload.program.size());
+                }
+            }
+            const uint64_t start_cycles = instances.front()->cpu.getCyclesElapsed();
+            ready.count_down();
+            start.wait();
+
+            for (uint64_t executed = 0; executed < options_.instructions; executed += SCALING_SLICE_INSTRUCTIONS) {
+                const uint64_t slice_end = std::min<uint64_t>(executed + SCALING_SLICE_INSTRUCTIONS, options_.instructions);
+                for (const std::unique_ptr<ScalingInstance>& instance : instances) {
+                    for (uint64_t i = executed + 1; i <= slice_end; i++) {
+                        instance->cpu.runInstruction();
+                        if (workload.irq_interval != 0 && i % workload.irq_interval == 0) instance->cpu.irq();
+                    }
+                }
+            }
+
+            uint64_t cycles = 0;
+            for (const std::unique_ptr<ScalingInstance>& instance : instances) {
+                cycles += instance->cpu.getCyclesElapsed() - start_cycles;
+            }
+            // Written once at the end, so sharing a cache line with other threads does not matter
+            thread_cycles[thread_index] = cycles;
+        });
+    }
+
+    ready.arrive_and_wait();
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    start.count_down();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+    result.instructions = options_.instructions * result.threads * result.instances_per_thread;
+    result.cycles = 0;
+    for (const uint64_t& cycles : thread_cycles) {
+        result.cycles += cycles;
+    }
+    return std::chrono::duration<double>(end_time - start_time).count();
+}
+
+uint64_t BenchmarkRunner::startMachine(const MemoryUnit& image) {
+    MOS6502 cpu;
+    MemoryUnit ram(image);
+    BUS bus(cpu, ram);
+    const uint64_t start_cycles = cpu.getCyclesElapsed();
+    cpu.runInstruction();
+    return cpu.getCyclesElapsed() - start_cycles;
+}
+
+BenchmarkResult BenchmarkRunner::measureStartup(const MemoryUnit& image) const {
+    BenchmarkResult result{"startup in-process", 1, 0, {}, {}, {}};
+    for (uint32_t i = 0; i < options_.warmup_repetitions + options_.repetitions; i++) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        result.cycles = startMachine(image);
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        if (i >= options_.warmup_repetitions) {
+            result.seconds.push_back(std::chrono::duration<double>(end - start).count());
+        }
+    }
+    return result;
+}
+
+BenchmarkResult BenchmarkRunner::measureProcessStartup(const std::string& executable, const std::vector<std::string>& arguments) const {
+    std::vector<char*> argv{const_cast<char*>(executable.c_str())};
+    for (const std::string& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    BenchmarkResult result{"startup process", 1, 0, {}, {}, {}};
+    for (uint32_t i = 0; i < options_.warmup_repetitions + options_.repetitions; i++) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        pid_t child;
+        int status = 0;
+        if (posix_spawn(&child, executable.c_str(), nullptr, nullptr, argv.data(), environ) != 0 ||
+            waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            throw std::runtime_error("Unable to spawn " + executable);
+        }
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        if (i >= options_.warmup_repetitions) {
+            result.seconds.push_back(std::chrono::duration<double>(end - start).count());
+        }
+    }
+    return result;
+}
+
+void BenchmarkRunner::writeLatencyReport(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::left << std::setw(20) << "Startup" << std::right << std::setw(10) << "Samples";
+    out << std::setw(12) << "p50 us" << std::setw(12) << "p90 us" << std::setw(12) << "p99 us" << std::setw(12) << "mean us" << "\n";
+    for (const BenchmarkResult& result : results) {
+        std::vector<double> sorted_seconds = result.seconds;
+        std::sort(sorted_seconds.begin(), sorted_seconds.end());
+        auto percentile = [&sorted_seconds](const double& fraction) {
+            return sorted_seconds[std::min<size_t>(sorted_seconds.size() - 1, static_cast<size_t>(fraction * sorted_seconds.size()))] * 1e6;
+        };
+        double total_seconds = 0;
+        for (const double& seconds : sorted_seconds) {
+            total_seconds += seconds;
+        }
+        out << std::left << std::setw(20) << result.name << std::right << std::setw(10) << sorted_seconds.size() << std::fixed << std::setprecision(2);
+        out << std::setw(12) << percentile(0.50) << std::setw(12) << percentile(0.90) << std::setw(12) << percentile(0.99);
+        out << std::setw(12) << total_seconds / sorted_seconds.size() * 1e6 << "\n";
+    }
+    out << std::defaultfloat;
+}
+
+void BenchmarkRunner::writeReport(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::left << std::setw(12) << "Workload" << std::right << std::setw(14) << "MIPS" << std::setw(14) << "Cycles MHz";
+    out << std::setw(12) << "Real-time" << std::setw(12) << "Spread" << "\n";
+    for (const BenchmarkResult& result : results) {
+        const double median_seconds = result.medianSeconds();
+        const auto [fastest, slowest] = std::minmax_element(result.seconds.begin(), result.seconds.end());
+        const double cycles_mhz = result.cycles / median_seconds / 1e6;
+        out << std::left << std::setw(12) << result.name << std::right << std::fixed << std::setprecision(2);
+        out << std::setw(14) << result.instructions / median_seconds / 1e6;
+        out << std::setw(14) << cycles_mhz;
+        out << std::setw(11) << cycles_mhz / MOS6502_CLOCK_SPEED << "x";
+        out << std::setw(11) << (*slowest - *fastest) / median_seconds * 100 << "%\n";
+    }
+    out << std::defaultfloat;
+}
+
+void BenchmarkRunner::writeScalingReport(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << std::left << std::setw(36) << "Workload" << std::right << std::setw(9) << "Threads" << std::setw(11) << "Instances";
+    out << std::setw(14) << "MIPS" << std::setw(14) << "MIPS/thread" << std::setw(12) << "Efficiency" << "\n";
+    for (const BenchmarkResult& result : results) {
+        const double mips = result.instructions / result.medianSeconds() / 1e6;
+        const double thread_mips = mips / result.threads;
+        // Names are "<workload> <layout> <threads>x<instances per thread>"
+        const std::string series = result.name.substr(0, result.name.rfind(' '));
+        const auto single_thread = std::find_if(results.begin(), results.end(), [&](const BenchmarkResult& other) {
+            return other.threads == 1 && other.instances_per_thread == result.instances_per_thread && other.name.starts_with(series + " ");
+        });
+        out << std::left << std::setw(36) << result.name << std::right << std::setw(9) << result.threads;
+        out << std::setw(11) << result.threads * result.instances_per_thread << std::fixed << std::setprecision(2);
+        out << std::setw(14) << mips << std::setw(14) << thread_mips;
+        if (single_thread == results.end()) {
+            out << std::setw(12) << "n/a" << "\n";
+        }
+        else {
+            const double single_thread_mips = single_thread->instructions / single_thread->medianSeconds() / 1e6;
+            out << std::setw(11) << thread_mips / single_thread_mips * 100 << "%\n";
+        }
+    }
+    out << std::defaultfloat;
+}
+
+void BenchmarkRunner::writeCostReport(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    std::map<std::string, std::pair<double, uint32_t>> mode_costs;
+    out << std::left << std::setw(28) << "Instruction" << std::right << std::setw(12) << "ns/instr" << std::setw(14) << "cycles/instr" << "\n";
+    for (const BenchmarkResult& result : results) {
+        const double ns_per_instruction = result.medianSeconds() / result.instructions * 1e9;
+        out << std::left << std::setw(28) << result.name << std::right << std::fixed << std::setprecision(2);
+        out << std::setw(12) << ns_per_instruction << std::setw(14) << static_cast<double>(result.cycles) / result.instructions << "\n";
+
+        // Names are "<opcode> <mnemonic> <addressing mode> [variant]"
+        std::stringstream name(result.name);
+        std::string opcode, mnemonic, addressing_mode;
+        name >> opcode >> mnemonic >> addressing_mode;
+        mode_costs[addressing_mode].first += ns_per_instruction;
+        mode_costs[addressing_mode].second++;
+    }
+
+    out << "\n" << std::left << std::setw(28) << "Addressing Mode" << std::right << std::setw(12) << "ns/instr" << std::setw(14) << "workloads" << "\n";
+    for (const auto& [addressing_mode, cost] : mode_costs) {
+        out << std::left << std::setw(28) << addressing_mode << std::right << std::setw(12) << cost.first / cost.second << std::setw(14) << cost.second << "\n";
+    }
+    out << std::defaultfloat;
+}
+
+void BenchmarkRunner::writeCounterReport(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "Host counters per emulated instruction\n" << std::left << std::setw(28) << "Workload" << std::right;
+    for (const std::string_view& counter_name : PerfCounters::counter_names) {
+        out << std::setw(15) << counter_name;
+    }
+    out << std::setw(8) << "IPC" << "\n";
+    for (const BenchmarkResult& result : results) {
+        out << std::left << std::setw(28) << result.name << std::right << std::fixed << std::setprecision(3);
+        const double emulated_instructions = static_cast<double>(result.instructions) * result.seconds.size();
+        for (const std::string_view& counter_name : PerfCounters::counter_names) {
+            const auto count = result.counters.find(std::string(counter_name));
+            if (count == result.counters.end()) {
+                out << std::setw(15) << "n/a";
+            }
+            else {
+                out << std::setw(15) << count->second / emulated_instructions;
+            }
+        }
+        const auto cycles = result.counters.find("cycles");
+        const auto instructions = result.counters.find("instructions");
+        if (cycles == result.counters.end() || instructions == result.counters.end() || cycles->second == 0) {
+            out << std::setw(8) << "n/a" << "\n";
+        }
+        else {
+            out << std::setw(8) << static_cast<double>(instructions->second) / cycles->second << "\n";
+        }
+    }
+    out << std::defaultfloat;
+    if (!results.empty() && !results.front().counters_unavailable.empty()) {
+        out << "Hardware counters unavailable (" << results.front().counters_unavailable << "), ";
+        out << "check /proc/sys/kernel/perf_event_paranoid or the container's seccomp profile\n";
+    }
+}
+
+json BenchmarkRunner::toJSON(const std::string& suite, const std::vector<BenchmarkResult>& results) const {
+    json results_json = json::array();
+    for (const BenchmarkResult& result : results) {
+        results_json.push_back({
+            {"name", result.name},
+            {"instructions", result.instructions},
+            {"cycles", result.cycles},
+            {"seconds", result.seconds},
+            {"counters", result.counters},
+            {"threads", result.threads},
+            {"instances_per_thread", result.instances_per_thread},
+        });
+    }
+    return json{
+        {"metadata", {
+            {"suite", suite},
+            {"host", host_metadata()},
+            {"build", {{"compiler", __VERSION__}, {"flags", MOS6502_BUILD_FLAGS}, {"core_fingerprint", MOS6502_CORE_FINGERPRINT}}},
+            {"options", {{"instructions", options_.instructions}, {"warmup_repetitions", options_.warmup_repetitions}, {"repetitions", options_.repetitions}, {"hardware_counters", options_.hardware_counters}}},
+        }},
+        {"results", results_json},
+    };
+}
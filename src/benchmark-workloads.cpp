@@ -0,0 +1,335 @@
+#include "benchmark-workloads.hpp"
+// Standard Library Includes
+#include <sstream>
+#include <iomanip>
+#include <optional>
+#include <array>
+#include <algorithm>
+// Project Includes
+#include "mos6502.hpp"
+
+// Microbenchmark memory: operands point into the data table, the indirect pointer lives at $F0
+#define MICROBENCHMARK_COPIES 64
+#define MICROBENCHMARK_ZERO_PAGE 0x40
+#define MICROBENCHMARK_ABSOLUTE 0x0480
+#define MICROBENCHMARK_PAGE_CROSS_BASE 0x04F8
+#define MICROBENCHMARK_INDEX 0x10
+#define MICROBENCHMARK_POINTER 0xF0
+#define MICROBENCHMARK_JUMP_POINTER 0x60
+
+// The status flag each branch opcode tests, and whether it branches when that flag is set
+struct BranchCondition {
+    uint8_t opcode;
+    uint8_t flag_mask;
+    bool taken_when_set;
+};
+
+static const std::array<BranchCondition, 8> branch_conditions = {{
+    {0x10, 0x80, false}, {0x30, 0x80, true}, {0x50, 0x40, false}, {0x70, 0x40, true},
+    {0x90, 0x01, false}, {0xB0, 0x01, true}, {0xD0, 0x02, false}, {0xF0, 0x02, true},
+}};
+
+static std::string microbenchmark_name(const uint8_t& opcode, const std::string& variant) {
+    std::stringstream name;
+    name << std::hex << std::setw(2) << std::setfill('0') << unsigned(opcode) << " ";
+    name << MOS6502::instruction_lookup_table.at(opcode).name << " " << MOS6502::getAddressingModeName(opcode);
+    if (!variant.empty()) name << " " << variant;
+    return name.str();
+}
+
+static void place(std::vector<uint8_t>& program, const uint16_t& address, const std::vector<uint8_t>& bytes) {
+    std::copy(bytes.begin(), bytes.end(), program.begin() + (address - WORKLOAD_LOAD_ADDRESS));
+}
+
+// Setup at WORKLOAD_LOAD_ADDRESS: points $F0 at the operand data and $60 at the entry, loads X and Y with
+//   MICROBENCHMARK_INDEX and the status flags with status, optionally fills the stack page and jumps to entry
+static BenchmarkWorkload make_microbenchmark(const std::string& name, const uint8_t& status, const uint16_t& pointer, const uint16_t& entry, const std::optional<uint8_t>& stack_fill = std::nullopt) {
+    std::vector<uint8_t> setup{
+        0xA9, static_cast<uint8_t>(pointer & 0x00FF), 0x85, MICROBENCHMARK_POINTER,
+        0xA9, static_cast<uint8_t>(pointer >> 8), 0x85, MICROBENCHMARK_POINTER + 1,
+        0xA9, static_cast<uint8_t>(entry & 0x00FF), 0x85, MICROBENCHMARK_JUMP_POINTER,
+        0xA9, static_cast<uint8_t>(entry >> 8), 0x85, MICROBENCHMARK_JUMP_POINTER + 1,
+        0xA2, MICROBENCHMARK_INDEX, 0xA0, MICROBENCHMARK_INDEX,
+        0xA9, status, 0x48, 0xA9, 0x01, 0x28,
+    };
+    // After PLP so the pushed status does not land in the filled page, RTS and RTI ignore the flags it changes
+    if (stack_fill.has_value()) {
+        setup.insert(setup.end(), {0xA9, *stack_fill, 0xA2, 0x00, 0x9D, 0x00, 0x01, 0xE8, 0xD0, 0xFA});
+    }
+    setup.insert(setup.end(), {0x4C, static_cast<uint8_t>(entry & 0x00FF), static_cast<uint8_t>(entry >> 8)});
+
+    BenchmarkWorkload workload{name, "", std::vector<uint8_t>(0x0200, 0x00), WORKLOAD_LOAD_ADDRESS, 0};
+    place(workload.program, WORKLOAD_LOAD_ADDRESS, setup);
+    return workload;
+}
+
+// MICROBENCHMARK_COPIES back to back copies of the instruction, then a JMP back to the first one
+static BenchmarkWorkload make_unrolled_microbenchmark(const uint8_t& opcode, const std::string& variant, const uint8_t& status, const uint16_t& base) {
+    BenchmarkWorkload workload = make_microbenchmark(microbenchmark_name(opcode, variant), status, base, MICROBENCHMARK_ENTRY_ADDRESS);
+    const std::string_view addressing_mode = MOS6502::getAddressingModeName(opcode);
+    std::vector<uint8_t> instruction{opcode};
+    if (addressing_mode == "IMM") instruction.push_back(0x01);
+    else if (addressing_mode == "ZP0" || addressing_mode == "ZPX" || addressing_mode == "ZPY") instruction.push_back(MICROBENCHMARK_ZERO_PAGE);
+    else if (addressing_mode == "IZX") instruction.push_back(MICROBENCHMARK_POINTER - MICROBENCHMARK_INDEX);
+    else if (addressing_mode == "IZY") instruction.push_back(MICROBENCHMARK_POINTER);
+    else if (addressing_mode == "REL") instruction.push_back(0x00);
+    else if (instruction.size() < MOS6502::getInstructionLength(opcode)) instruction.insert(instruction.end(), {static_cast<uint8_t>(base & 0x00FF), static_cast<uint8_t>(base >> 8)});
+
+    std::vector<uint8_t> body;
+    for (uint32_t i = 0; i < MICROBENCHMARK_COPIES; i++) {
+        body.insert(body.end(), instruction.begin(), instruction.end());
+    }
+    body.insert(body.end(), {0x4C, MICROBENCHMARK_ENTRY_ADDRESS & 0x00FF, MICROBENCHMARK_ENTRY_ADDRESS >> 8});
+    place(workload.program, MICROBENCHMARK_ENTRY_ADDRESS, body);
+    return workload;
+}
+
+// Hand assembled, every program is loaded at WORKLOAD_LOAD_ADDRESS ($0200)
+const std::vector<BenchmarkWorkload>& syntheticWorkloads() {
+    static const std::vector<BenchmarkWorkload> workloads = {
+        {
+            "arithmetic", "8x8 bit shift and add multiply in a loop",
+            {
+                0xD8,               // $0200 start: CLD
+                0xA9, 0x00,         // $0201 LDA #0
+                0x85, 0x20,         // $0203 STA $20
+                0xA5, 0x20,         // $0205 loop: LDA $20
+                0x85, 0x10,         // $0207 STA $10
+                0x49, 0x5A,         // $0209 EOR #$5A
+                0x85, 0x11,         // $020B STA $11
+                0xA9, 0x00,         // $020D LDA #0
+                0x85, 0x12,         // $020F STA $12
+                0x85, 0x13,         // $0211 STA $13
+                0x85, 0x14,         // $0213 STA $14
+                0xA2, 0x08,         // $0215 LDX #8
+                0x46, 0x11,         // $0217 mul: LSR $11
+                0x90, 0x0D,         // $0219 BCC skip
+                0x18,               // $021B CLC
+                0xA5, 0x12,         // $021C LDA $12
+                0x65, 0x10,         // $021E ADC $10
+                0x85, 0x12,         // $0220 STA $12
+                0xA5, 0x13,         // $0222 LDA $13
+                0x65, 0x14,         // $0224 ADC $14
+                0x85, 0x13,         // $0226 STA $13
+                0x06, 0x10,         // $0228 skip: ASL $10
+                0x26, 0x14,         // $022A ROL $14
+                0xCA,               // $022C DEX
+                0xD0, 0xE8,         // $022D BNE mul
+                0xE6, 0x20,         // $022F INC $20
+                0x4C, 0x05, 0x02,   // $0231 JMP loop
+            },
+            WORKLOAD_LOAD_ADDRESS, 0,
+        },
+        {
+            "memcpy", "1kB copy through (zp),Y pointers",
+            {
+                0xA9, 0x00,         // $0200 start: LDA #$00
+                0x85, 0x00,         // $0202 STA $00
+                0x85, 0x02,         // $0204 STA $02
+                0xA9, 0x10,         // $0206 LDA #$10
+                0x85, 0x01,         // $0208 STA $01
+                0xA9, 0x20,         // $020A LDA #$20
+                0x85, 0x03,         // $020C STA $03
+                0xA2, 0x04,         // $020E LDX #4
+                0xA0, 0x00,         // $0210 LDY #0
+                0xB1, 0x00,         // $0212 copy: LDA ($00),Y
+                0x91, 0x02,         // $0214 STA ($02),Y
+                0xC8,               // $0216 INY
+                0xD0, 0xF9,         // $0217 BNE copy
+                0xE6, 0x01,         // $0219 INC $01
+                0xE6, 0x03,         // $021B INC $03
+                0xCA,               // $021D DEX
+                0xD0, 0xF2,         // $021E BNE copy
+                0x4C, 0x00, 0x02,   // $0220 JMP start
+            },
+            WORKLOAD_LOAD_ADDRESS, 0,
+        },
+        {
+            "sort", "Bubble sort of 64 bytes refilled from an LFSR",
+            {
+                0xA9, 0x01,         // $0200 init: LDA #$01
+                0x85, 0x30,         // $0202 STA $30
+                0xA2, 0x3F,         // $0204 start: LDX #63
+                0xA5, 0x30,         // $0206 fill: LDA $30
+                0x0A,               // $0208 ASL A
+                0x90, 0x02,         // $0209 BCC nofb
+                0x49, 0x1D,         // $020B EOR #$1D
+                0x85, 0x30,         // $020D nofb: STA $30
+                0x9D, 0x00, 0x03,   // $020F STA $0300,X
+                0xCA,               // $0212 DEX
+                0x10, 0xF1,         // $0213 BPL fill
+                0xA0, 0x00,         // $0215 sort: LDY #0
+                0xA2, 0x00,         // $0217 LDX #0
+                0xBD, 0x00, 0x03,   // $0219 inner: LDA $0300,X
+                0xDD, 0x01, 0x03,   // $021C CMP $0301,X
+                0x90, 0x0F,         // $021F BCC next
+                0xF0, 0x0D,         // $0221 BEQ next
+                0x48,               // $0223 PHA
+                0xBD, 0x01, 0x03,   // $0224 LDA $0301,X
+                0x9D, 0x00, 0x03,   // $0227 STA $0300,X
+                0x68,               // $022A PLA
+                0x9D, 0x01, 0x03,   // $022B STA $0301,X
+                0xA0, 0x01,         // $022E LDY #1
+                0xE8,               // $0230 next: INX
+                0xE0, 0x3F,         // $0231 CPX #63
+                0xD0, 0xE4,         // $0233 BNE inner
+                0xC0, 0x00,         // $0235 CPY #0
+                0xD0, 0xDC,         // $0237 BNE sort
+                0x4C, 0x04, 0x02,   // $0239 JMP start
+            },
+            WORKLOAD_LOAD_ADDRESS, 0,
+        },
+        {
+            "bcd", "32 bit decimal counter and 16 bit decimal subtraction",
+            {
+                0xF8,               // $0200 start: SED
+                0x18,               // $0201 loop: CLC
+                0xA5, 0x40,         // $0202 LDA $40
+                0x69, 0x01,         // $0204 ADC #$01
+                0x85, 0x40,         // $0206 STA $40
+                0xA5, 0x41,         // $0208 LDA $41
+                0x69, 0x00,         // $020A ADC #$00
+                0x85, 0x41,         // $020C STA $41
+                0xA5, 0x42,         // $020E LDA $42
+                0x69, 0x00,         // $0210 ADC #$00
+                0x85, 0x42,         // $0212 STA $42
+                0xA5, 0x43,         // $0214 LDA $43
+                0x69, 0x00,         // $0216 ADC #$00
+                0x85, 0x43,         // $0218 STA $43
+                0x38,               // $021A SEC
+                0xA5, 0x44,         // $021B LDA $44
+                0xE9, 0x07,         // $021D SBC #$07
+                0x85, 0x44,         // $021F STA $44
+                0xA5, 0x45,         // $0221 LDA $45
+                0xE9, 0x00,         // $0223 SBC #$00
+                0x85, 0x45,         // $0225 STA $45
+                0x4C, 0x01, 0x02,   // $0227 JMP loop
+            },
+            WORKLOAD_LOAD_ADDRESS, 0,
+        },
+        {
+            "branch", "Data dependent branches over a pseudo random table",
+            {
+                0xA2, 0x00,         // $0200 start: LDX #0
+                0xBD, 0x00, 0x10,   // $0202 loop: LDA $1000,X
+                0x30, 0x0C,         // $0205 BMI neg
+                0xC9, 0x40,         // $0207 CMP #$40
+                0xB0, 0x04,         // $0209 BCS big
+                0xC8,               // $020B INY
+                0x4C, 0x1E, 0x02,   // $020C JMP next
+                0x88,               // $020F big: DEY
+                0x4C, 0x1E, 0x02,   // $0210 JMP next
+                0x29, 0x01,         // $0213 neg: AND #$01
+                0xF0, 0x05,         // $0215 BEQ even
+                0xE6, 0x50,         // $0217 INC $50
+                0x4C, 0x1E, 0x02,   // $0219 JMP next
+                0xC6, 0x50,         // $021C even: DEC $50
+                0xE8,               // $021E next: INX
+                0xD0, 0xE1,         // $021F BNE loop
+                0x4C, 0x00, 0x02,   // $0221 JMP start
+            },
+            WORKLOAD_LOAD_ADDRESS, 0,
+        },
+        {
+            "interrupt", "Short main loop interrupted by an IRQ every 16 instructions",
+            {
+                // MOS6502::irq pushes the status with I set, so the loop re-enables interrupts after every RTI
+                0x58,               // $0200 loop: CLI
+                0xE6, 0x60,         // $0201 INC $60
+                0xA5, 0x60,         // $0203 LDA $60
+                0x45, 0x61,         // $0205 EOR $61
+                0x85, 0x61,         // $0207 STA $61
+                0x4C, 0x00, 0x02,   // $0209 JMP loop
+                0x48,               // $020C irq: PHA
+                0x8A,               // $020D TXA
+                0x48,               // $020E PHA
+                0xE6, 0x62,         // $020F INC $62
+                0xA6, 0x62,         // $0211 LDX $62
+                0xBD, 0x00, 0x10,   // $0213 LDA $1000,X
+                0x85, 0x63,         // $0216 STA $63
+                0x68,               // $0218 PLA
+                0xAA,               // $0219 TAX
+                0x68,               // $021A PLA
+                0x40,               // $021B RTI
+            },
+            0x020C, 16,
+        },
+    };
+    return workloads;
+}
+
+std::vector<BenchmarkWorkload> microbenchmarkWorkloads() {
+    std::vector<BenchmarkWorkload> workloads;
+    for (unsigned int opcode = 0; opcode < MOS6502::instruction_lookup_table.size(); opcode++) {
+        const std::string_view mnemonic = MOS6502::instruction_lookup_table.at(opcode).name;
+        const std::string_view addressing_mode = MOS6502::getAddressingModeName(opcode);
+        if (mnemonic == "???") continue;
+
+        // Control flow cannot be unrolled, each of these loops on itself
+        if (addressing_mode == "REL") {
+            const BranchCondition& condition = *std::find_if(branch_conditions.begin(), branch_conditions.end(), [opcode](const BranchCondition& branch) {
+                return branch.opcode == opcode;
+            });
+            const uint8_t taken_status = condition.taken_when_set ? 0x20 | condition.flag_mask : 0x20;
+            const uint8_t not_taken_status = condition.taken_when_set ? 0x20 : 0x20 | condition.flag_mask;
+
+            BenchmarkWorkload taken = make_microbenchmark(microbenchmark_name(opcode, "taken"), taken_status, MICROBENCHMARK_ABSOLUTE, MICROBENCHMARK_ENTRY_ADDRESS);
+            place(taken.program, MICROBENCHMARK_ENTRY_ADDRESS, {static_cast<uint8_t>(opcode), 0xFE});
+            workloads.push_back(std::move(taken));
+
+            // $0300 branches back to $02F2, which branches forward to $0300, both crossing a page
+            BenchmarkWorkload page_cross = make_microbenchmark(microbenchmark_name(opcode, "taken page-cross"), taken_status, MICROBENCHMARK_ABSOLUTE, MICROBENCHMARK_ENTRY_ADDRESS);
+            place(page_cross.program, MICROBENCHMARK_ENTRY_ADDRESS, {static_cast<uint8_t>(opcode), 0xF0});
+            place(page_cross.program, MICROBENCHMARK_ENTRY_ADDRESS - 0x0E, {static_cast<uint8_t>(opcode), 0x0C});
+            workloads.push_back(std::move(page_cross));
+
+            workloads.push_back(make_unrolled_microbenchmark(opcode, "not-taken", not_taken_status, MICROBENCHMARK_ABSOLUTE));
+        }
+        else if (mnemonic == "JMP" || mnemonic == "JSR" || mnemonic == "BRK") {
+            // JMP and JSR target themselves, JMP indirect goes through $60 and BRK through the IRQ vector
+            const uint8_t operand = mnemonic == "JMP" && addressing_mode == "IND" ? MICROBENCHMARK_JUMP_POINTER : MICROBENCHMARK_ENTRY_ADDRESS & 0x00FF;
+            const uint8_t operand_high = mnemonic == "JMP" && addressing_mode == "IND" ? 0x00 : MICROBENCHMARK_ENTRY_ADDRESS >> 8;
+            BenchmarkWorkload workload = make_microbenchmark(microbenchmark_name(opcode, ""), 0x20, MICROBENCHMARK_ABSOLUTE, MICROBENCHMARK_ENTRY_ADDRESS);
+            place(workload.program, MICROBENCHMARK_ENTRY_ADDRESS, {static_cast<uint8_t>(opcode), operand, operand_high});
+            workload.interrupt_handler = MICROBENCHMARK_ENTRY_ADDRESS;
+            workloads.push_back(std::move(workload));
+        }
+        else if (mnemonic == "RTS" || mnemonic == "RTI") {
+            // The stack page is filled with $03, RTS returns to $0303 + 1 and RTI to $0303 with status $03
+            const uint16_t entry = mnemonic == "RTS" ? 0x0304 : 0x0303;
+            BenchmarkWorkload workload = make_microbenchmark(microbenchmark_name(opcode, ""), 0x20, MICROBENCHMARK_ABSOLUTE, entry, 0x03);
+            place(workload.program, entry, {static_cast<uint8_t>(opcode)});
+            workloads.push_back(std::move(workload));
+        }
+        else {
+            workloads.push_back(make_unrolled_microbenchmark(opcode, "", 0x20, MICROBENCHMARK_ABSOLUTE));
+            if (addressing_mode == "ABX" || addressing_mode == "ABY" || addressing_mode == "IZY") {
+                workloads.push_back(make_unrolled_microbenchmark(opcode, "page-cross", 0x20, MICROBENCHMARK_PAGE_CROSS_BASE));
+            }
+        }
+    }
+    return workloads;
+}
+
+MemoryUnit buildWorkloadImage(const BenchmarkWorkload& workload) {
+    MemoryUnit image(65536);
+
+    // Same table for every run so workloads stay comparable across builds
+    uint32_t lcg_state = 0x6502;
+    for (uint16_t i = 0; i < WORKLOAD_DATA_SIZE; i++) {
+        lcg_state = lcg_state * 1103515245 + 12345;
+        image.write(WORKLOAD_DATA_ADDRESS + i, lcg_state >> 16);
+    }
+
+    for (size_t i = 0; i < workload.program.size(); i++) {
+        image.write(WORKLOAD_LOAD_ADDRESS + i, workload.program[i]);
+    }
+
+    image.write(MOS6502_NMI_PC_ADDRESS, workload.interrupt_handler & 0x00FF);
+    image.write(MOS6502_NMI_PC_ADDRESS + 1, workload.interrupt_handler >> 8);
+    image.write(MOS6502_STARTING_PC_ADDRESS, WORKLOAD_LOAD_ADDRESS & 0x00FF);
+    image.write(MOS6502_STARTING_PC_ADDRESS + 1, WORKLOAD_LOAD_ADDRESS >> 8);
+    image.write(MOS6502_IRQ_PC_ADDRESS, workload.interrupt_handler & 0x00FF);
+    image.write(MOS6502_IRQ_PC_ADDRESS + 1, workload.interrupt_handler >> 8);
+    return image;
+}
@@ -1,13 +1,57 @@
 #include "bus.hpp"
+// Standard Library Includes
+#include <algorithm>
 
-BUS::BUS(MOS6502& cpu, MemoryUnit& ram): cpu_(cpu), ram_(ram) {
+BUS::BUS(MOS6502& cpu, MemoryUnit& ram): cpu_(cpu), ram_(ram), rom_(nullptr), rom_start_(0), rom_size_(0), activity_recorder_(nullptr) {
     cpu_.connectBUS(this);
 }
 
 uint8_t BUS::readBusData(const uint16_t& address) const {
-    return ram_.read(address);
+    const uint8_t data = peekBusData(address);
+    if (activity_recorder_ != nullptr) [[unlikely]] {
+        activity_recorder_->push_back(Activity{address, data, Activity::Type::READ});
+    }
+    if (!observers_.empty()) [[unlikely]] {
+        for (BusObserver* observer : observers_) {
+            observer->onRead(address, data);
+        }
+    }
+    return data;
+}
+
+uint8_t BUS::peekBusData(const uint16_t& address) const {
+    return static_cast<uint16_t>(address - rom_start_) < rom_size_ ? rom_->read(address) : ram_.read(address);
 }
 
 bool BUS::writeBusData(const uint16_t& address, const uint8_t& data) {
+    if (activity_recorder_ != nullptr) [[unlikely]] {
+        activity_recorder_->push_back(Activity{address, data, Activity::Type::WRITE});
+    }
+    if (!observers_.empty()) [[unlikely]] {
+        for (BusObserver* observer : observers_) {
+            observer->onWrite(address, data);
+        }
+    }
+    if (static_cast<uint16_t>(address - rom_start_) < rom_size_) {
+        return false;
+    }
     return ram_.write(address, data);
 }
+
+void BUS::setActivityRecorder(std::vector<Activity>* recorder) {
+    activity_recorder_ = recorder;
+}
+
+void BUS::mapROM(const MemoryUnit* rom, const uint16_t& start_address, const uint32_t& size) {
+    rom_ = rom;
+    rom_start_ = start_address;
+    rom_size_ = rom == nullptr ? 0 : size;
+}
+
+void BUS::addObserver(BusObserver* observer) {
+    observers_.push_back(observer);
+}
+
+void BUS::removeObserver(BusObserver* observer) {
+    observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+}
@@ -0,0 +1,115 @@
+#include "call-graph-profiler.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <iomanip>
+#include <string>
+// Project Includes
+#include "mos6502.hpp"
+
+CallGraphProfiler::CallGraphProfiler(const SymbolTable& symbols):
+    symbols_{symbols}, nodes_{CallNode{0, 0, 1, 0, {}}}, shadow_call_stack_{*this}, frame_nodes_{}, started_{false} {}
+
+void CallGraphProfiler::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    if (!started_) [[unlikely]] {
+        nodes_[0].function = address;
+        shadow_call_stack_.addFunctionEntry(address);
+        started_ = true;
+    }
+    // The instruction ran in the path that was current when it was fetched
+    nodes_[frame_nodes_.empty() ? 0 : frame_nodes_.back()].self_cycles += cycles;
+    shadow_call_stack_.onInstruction(cpu, opcode);
+}
+
+void CallGraphProfiler::onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {
+    shadow_call_stack_.onInterrupt(cpu, interrupt);
+}
+
+void CallGraphProfiler::onCall(const ShadowCallStack::Frame& frame) {
+    const uint32_t node = childNode(frame_nodes_.empty() ? 0 : frame_nodes_.back(), frame.function);
+    nodes_[node].calls++;
+    frame_nodes_.push_back(node);
+}
+
+void CallGraphProfiler::onReturn(const ShadowCallStack::Frame& frame) {
+    frame_nodes_.pop_back();
+}
+
+void CallGraphProfiler::onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) {
+    // The tail call is made from the path that called the previous function
+    const uint32_t node = childNode(nodes_[frame_nodes_.back()].parent, frame.function);
+    nodes_[node].calls++;
+    frame_nodes_.back() = node;
+}
+
+uint32_t CallGraphProfiler::childNode(const uint32_t& parent, const uint16_t& function) {
+    const auto child = nodes_[parent].children.find(function);
+    if (child != nodes_[parent].children.end()) return child->second;
+    const uint32_t node = nodes_.size();
+    nodes_[parent].children.emplace(function, node);
+    nodes_.push_back(CallNode{function, parent, 0, 0, {}});
+    return node;
+}
+
+std::vector<CallGraphProfiler::FunctionCycles> CallGraphProfiler::getFunctionCycles() const {
+    // Children come after their parent, so a reverse pass sums every subtree
+    std::vector<uint64_t> subtree_cycles(nodes_.size());
+    for (uint32_t node = nodes_.size(); node-- > 0;) {
+        subtree_cycles[node] += nodes_[node].self_cycles;
+        if (node != 0) subtree_cycles[nodes_[node].parent] += subtree_cycles[node];
+    }
+
+    std::map<uint16_t, FunctionCycles> functions;
+    for (uint32_t node = 0; node < nodes_.size(); node++) {
+        const uint16_t function = nodes_[node].function;
+        FunctionCycles& function_cycles = functions.try_emplace(function, FunctionCycles{function, 0, 0, 0}).first->second;
+        function_cycles.calls += nodes_[node].calls;
+        function_cycles.exclusive_cycles += nodes_[node].self_cycles;
+
+        // A recursive call is already inside the subtree of its outermost call
+        bool recursive = false;
+        for (uint32_t ancestor = node; ancestor != 0 && !recursive;) {
+            ancestor = nodes_[ancestor].parent;
+            recursive = nodes_[ancestor].function == function;
+        }
+        if (!recursive) function_cycles.inclusive_cycles += subtree_cycles[node];
+    }
+
+    std::vector<FunctionCycles> function_list;
+    for (const auto& [function, function_cycles] : functions) {
+        function_list.push_back(function_cycles);
+    }
+    std::stable_sort(function_list.begin(), function_list.end(), [](const FunctionCycles& a, const FunctionCycles& b) {
+        return a.inclusive_cycles > b.inclusive_cycles;
+    });
+    return function_list;
+}
+
+void CallGraphProfiler::writeFoldedStacks(std::ostream& out) const {
+    for (uint32_t node = 0; node < nodes_.size(); node++) {
+        if (nodes_[node].self_cycles == 0) continue;
+        std::string path = symbols_.name(nodes_[node].function);
+        for (uint32_t ancestor = node; ancestor != 0;) {
+            ancestor = nodes_[ancestor].parent;
+            path = symbols_.name(nodes_[ancestor].function) + ";" + path;
+        }
+        out << path << " " << nodes_[node].self_cycles << "\n";
+    }
+}
+
+void CallGraphProfiler::writeReport(std::ostream& out, const size_t& top) const {
+    const std::vector<FunctionCycles> function_list = getFunctionCycles();
+    uint64_t total_cycles = 0;
+    for (const FunctionCycles& function_cycles : function_list) {
+        total_cycles += function_cycles.exclusive_cycles;
+    }
+    out << std::left << std::setw(24) << "Function" << std::right << std::setw(10) << "Calls" << std::setw(14) << "Inclusive";
+    out << std::setw(9) << "Incl" << std::setw(14) << "Exclusive" << std::setw(9) << "Excl" << "\n";
+    for (size_t i = 0; i < std::min(top, function_list.size()); i++) {
+        const FunctionCycles& function_cycles = function_list[i];
+        out << std::left << std::setw(24) << symbols_.name(function_cycles.address) << std::right << std::setw(10) << function_cycles.calls;
+        out << std::fixed << std::setprecision(2) << std::setw(14) << function_cycles.inclusive_cycles;
+        out << std::setw(8) << 100.0 * function_cycles.inclusive_cycles / total_cycles << "%";
+        out << std::setw(14) << function_cycles.exclusive_cycles;
+        out << std::setw(8) << 100.0 * function_cycles.exclusive_cycles / total_cycles << "%" << std::defaultfloat << "\n";
+    }
+}
@@ -0,0 +1,131 @@
+#include "code-data-logger.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <iomanip>
+// Project Includes
+#include "mos6502.hpp"
+
+#define CDL_ADDRESSES 65536
+#define OPCODE_JMP_IND 0x6C
+
+CodeDataLogger::CodeDataLogger():
+    flags_(CDL_ADDRESSES), next_opcode_address_{0}, expecting_opcode_{true}, started_{false},
+    operand_start_{0}, operand_size_{0}, last_data_address_{0}, data_accessed_{false} {}
+
+void CodeDataLogger::onRead(const uint16_t& address, const uint8_t& data) {
+    if (expecting_opcode_ && (address == next_opcode_address_ || !started_)) {
+        flags_[address] |= OPCODE;
+        operand_start_ = address + 1;
+        operand_size_ = MOS6502::getInstructionLength(data) - 1;
+        expecting_opcode_ = false;
+        started_ = true;
+    }
+    else if (static_cast<uint16_t>(address - operand_start_) < operand_size_) {
+        flags_[address] |= OPERAND;
+    }
+    else {
+        flags_[address] |= DATA_READ;
+        last_data_address_ = address;
+        data_accessed_ = true;
+    }
+}
+
+void CodeDataLogger::onWrite(const uint16_t& address, const uint8_t& data) {
+    flags_[address] |= DATA_WRITTEN;
+    last_data_address_ = address;
+    data_accessed_ = true;
+}
+
+void CodeDataLogger::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    const MOS6502::AddressingMode addressing_mode = MOS6502::instruction_lookup_table[opcode].addressing_mode;
+    const uint16_t program_counter = cpu.getState().program_counter;
+    if (opcode == OPCODE_JMP_IND) {
+        flags_[program_counter] |= INDIRECT_TARGET;
+    }
+    else if ((addressing_mode == MOS6502::AddressingMode::IZX || addressing_mode == MOS6502::AddressingMode::IZY) && data_accessed_) {
+        flags_[last_data_address_] |= INDIRECT_TARGET;
+    }
+    next_opcode_address_ = program_counter;
+    expecting_opcode_ = true;
+    operand_size_ = 0;
+    data_accessed_ = false;
+}
+
+void CodeDataLogger::onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {
+    next_opcode_address_ = cpu.getState().program_counter;
+    expecting_opcode_ = true;
+    data_accessed_ = false;
+}
+
+uint8_t CodeDataLogger::getFlags(const uint16_t& address) const {
+    return flags_[address];
+}
+
+void CodeDataLogger::mergeCDL(const std::string& file_path) {
+    std::ifstream file_in(file_path, std::ios::binary);
+    std::vector<uint8_t> file_flags(CDL_ADDRESSES);
+    file_in.read(reinterpret_cast<char*>(file_flags.data()), file_flags.size());
+    if (!file_in) {
+        throw std::runtime_error("Unable to read CDL file " + file_path);
+    }
+    for (uint32_t address = 0; address < CDL_ADDRESSES; address++) {
+        flags_[address] |= file_flags[address];
+    }
+}
+
+void CodeDataLogger::writeCDL(const std::string& file_path) const {
+    std::ofstream file_out(file_path, std::ios::binary | std::ios::trunc);
+    file_out.write(reinterpret_cast<const char*>(flags_.data()), flags_.size());
+    if (!file_out) {
+        throw std::runtime_error("Unable to write CDL file " + file_path);
+    }
+}
+
+void CodeDataLogger::writeLcov(std::ostream& out, const SourceMap& source_map) const {
+    // Per file, line to executed
+    std::map<std::string, std::map<uint32_t, bool>> file_lines;
+    for (const SourceMap::SourceLine& source_line : source_map.getLines()) {
+        uint8_t line_flags = 0;
+        for (const SourceMap::AddressRange& range : source_line.ranges) {
+            for (uint32_t i = 0; i < range.size; i++) {
+                line_flags |= flags_[static_cast<uint16_t>(range.start + i)];
+            }
+        }
+        if ((line_flags & (OPCODE | OPERAND)) == 0 && line_flags != 0) continue;
+        bool& executed = file_lines[source_line.file][source_line.line];
+        executed = executed || (line_flags & OPCODE);
+    }
+
+    out << "TN:\n";
+    for (const auto& [file, lines] : file_lines) {
+        uint32_t lines_hit = 0;
+        out << "SF:" << file << "\n";
+        for (const auto& [line, executed] : lines) {
+            out << "DA:" << line << "," << executed << "\n";
+            lines_hit += executed;
+        }
+        out << "LF:" << lines.size() << "\nLH:" << lines_hit << "\nend_of_record\n";
+    }
+}
+
+void CodeDataLogger::writeReport(std::ostream& out) const {
+    const std::pair<Flag, const char*> flag_names[] = {
+        {OPCODE, "opcode"}, {OPERAND, "operand"}, {DATA_READ, "data read"}, {DATA_WRITTEN, "data written"}, {INDIRECT_TARGET, "indirect target"},
+    };
+    for (const auto& [flag, name] : flag_names) {
+        uint32_t addresses = 0;
+        for (const uint8_t& address_flags : flags_) {
+            addresses += (address_flags & flag) != 0;
+        }
+        out << std::left << std::setw(18) << name << std::right << std::setw(8) << addresses << " addresses\n";
+    }
+    uint32_t code_bytes = 0, data_bytes = 0, untouched_bytes = 0;
+    for (const uint8_t& address_flags : flags_) {
+        code_bytes += (address_flags & (OPCODE | OPERAND)) != 0;
+        data_bytes += (address_flags & (OPCODE | OPERAND)) == 0 && address_flags != 0;
+        untouched_bytes += address_flags == 0;
+    }
+    out << code_bytes << " code bytes, " << data_bytes << " data-only bytes, " << untouched_bytes << " untouched bytes\n";
+}
@@ -0,0 +1,415 @@
+#include "conformance-runner.hpp"
+// Standard Library Includes
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <limits>
+#include <algorithm>
+#include <map>
+#include <cstring>
+// POSIX Includes
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// Project Includes
+#include "bus.hpp"
+#include "memory-unit.hpp"
+
+static std::string uint8_to_hex_string(const uint8_t& value) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(2) << std::setfill('0') << unsigned(value);
+    return ss.str();
+}
+
+// Writes sample count, nearest-rank percentiles and mean of samples (sorted in place)
+static void write_timing_row(std::ostream& out, const std::string& label, std::vector<uint32_t>& samples) {
+    out << std::left << std::setw(12) << label << std::right << std::setw(10) << samples.size();
+    if (samples.empty()) {
+        out << "\n";
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](const double& fraction) {
+        return samples[std::min<size_t>(samples.size() - 1, static_cast<size_t>(fraction * samples.size()))];
+    };
+    double total_ns = 0;
+    for (const uint32_t& sample : samples) {
+        total_ns += sample;
+    }
+    out << std::setw(10) << percentile(0.50) << std::setw(10) << percentile(0.90) << std::setw(10) << percentile(0.99);
+    out << std::setw(12) << std::fixed << std::setprecision(1) << total_ns / samples.size() << "\n";
+}
+
+static void write_timing_header(std::ostream& out, const std::string& label) {
+    out << std::left << std::setw(12) << label << std::right << std::setw(10) << "Tests";
+    out << std::setw(10) << "p50 ns" << std::setw(10) << "p90 ns" << std::setw(10) << "p99 ns" << std::setw(12) << "mean ns" << "\n";
+}
+
+ConformanceRunner::ConformanceRunner(const ConformanceOptions& options):
+    options_{options}, jobs_{options.jobs > 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency())} {}
+
+std::vector<uint8_t> ConformanceRunner::officialOpcodes() {
+    std::vector<uint8_t> opcodes;
+    for (unsigned int i = 0; i < MOS6502::instruction_lookup_table.size(); i++) {
+        // Skip Unofficial OPCODE Tests
+        if (MOS6502::instruction_lookup_table.at(i).name == "???") continue;
+        opcodes.push_back(i);
+    }
+    return opcodes;
+}
+
+std::string ConformanceRunner::testFilePath(const uint8_t& opcode) const {
+    return options_.test_directory + "/" + uint8_to_hex_string(opcode) + options_.test_extension;
+}
+
+ConformanceRunner::OpcodeResult ConformanceRunner::runOpcode(const uint8_t& opcode) const {
+    MOS6502 cpu;
+    MemoryUnit ram(65536); // 64kB for testing
+    BUS bus(cpu, ram);
+
+    std::ostringstream log;
+    OpcodeResult opcode_result{opcode, JSONTestHarness::Result::TEST_FAILED, {0, 0, std::nullopt, "", "", {}}, "", false, "", {0, 0, ""}, 0};
+    try {
+        JSONTestHarness json_test_harness{cpu, testFilePath(opcode), log, options_.harness};
+        if (options_.harness.quiet) {
+            opcode_result.summary = json_test_harness.runAllTests();
+            if (!opcode_result.summary.first_failure_index.has_value()) {
+                opcode_result.result = JSONTestHarness::Result::ALL_TESTS_PASSED;
+            }
+        }
+        else {
+            while (true) {
+                JSONTestHarness::Result step_result = json_test_harness.singleInstructionStep();
+                if (step_result != JSONTestHarness::Result::TEST_OK) {
+                    opcode_result.result = step_result;
+                    break;
+                }
+            }
+            opcode_result.summary = json_test_harness.getSummary();
+        }
+    }
+    catch (const std::exception& error) {
+        log << "Unable to run " << testFilePath(opcode) << ": " << error.what() << "\n";
+    }
+
+    if (options_.harness.quiet) {
+        writeOpcodeSummary(log, opcode_result);
+    }
+    opcode_result.log = log.str();
+    return opcode_result;
+}
+
+void ConformanceRunner::writeOpcodeSummary(std::ostream& out, const OpcodeResult& opcode_result) {
+    out << uint8_to_hex_string(opcode_result.opcode) << " " << MOS6502::instruction_lookup_table.at(opcode_result.opcode).name << ": ";
+    out << opcode_result.summary.tests_passed << "/" << opcode_result.summary.tests_run << " passed";
+    out << (opcode_result.cached ? " (cached)\n" : "\n");
+    if (opcode_result.summary.first_failure_index.has_value()) {
+        out << "First failure: " << opcode_result.summary.first_failure_diff;
+    }
+}
+
+ConformanceRunner::OpcodeResult ConformanceRunner::testOpcode(const uint8_t& opcode, const ResultCache* cache) const {
+    if (cache == nullptr) {
+        return runOpcode(opcode);
+    }
+
+    const ResultCache::FileHash test_file = cache->hashTestFile(opcode, testFilePath(opcode));
+    const std::string cache_key = ResultCache::opcodeKey(opcode, test_file, options_.harness);
+    const std::optional<ResultCache::Entry> cached = options_.force_full_run ? std::nullopt : cache->lookup(opcode, cache_key);
+    if (!cached.has_value()) {
+        OpcodeResult opcode_result = runOpcode(opcode);
+        opcode_result.cache_key = cache_key;
+        opcode_result.test_file = test_file;
+        return opcode_result;
+    }
+
+    const JSONTestHarness::Result result = cached->passed ? JSONTestHarness::Result::ALL_TESTS_PASSED : JSONTestHarness::Result::TEST_FAILED;
+    OpcodeResult opcode_result{opcode, result, cached->summary, "", true, cache_key, test_file, 0};
+    std::ostringstream log;
+    if (options_.harness.quiet) {
+        writeOpcodeSummary(log, opcode_result);
+    }
+    else {
+        log << "Cached result for " << testFilePath(opcode) << ": " << (cached->passed ? "All Test Passed" : "Failed") << "\n";
+        if (!cached->passed) {
+            log << "First failure: " << cached->summary.first_failure_diff;
+        }
+    }
+    opcode_result.log = log.str();
+    return opcode_result;
+}
+
+bool ConformanceRunner::run(std::ostream& out) {
+    const std::vector<uint8_t> opcodes = officialOpcodes();
+    std::vector<std::optional<OpcodeResult>> results(opcodes.size());
+
+    // Timing needs the instructions to actually run, so benchmarks bypass the cache
+    std::optional<ResultCache> cache;
+    if (!options_.cache_path.empty() && !options_.harness.time_instructions) {
+        cache.emplace(options_.cache_path);
+    }
+
+    const ResultCache* cache_ptr = cache.has_value() ? &*cache : nullptr;
+    const size_t opcodes_reported = options_.processes > 0 ? runWorkerProcesses(opcodes, results, cache_ptr, out) : runWorkerThreads(opcodes, results, cache_ptr, out);
+
+    results_.clear();
+    unsigned int opcodes_passed = 0;
+    unsigned int opcodes_cached = 0;
+    for (size_t index = 0; index < opcodes_reported; index++) {
+        OpcodeResult& opcode_result = *results[index];
+        if (opcode_result.result == JSONTestHarness::Result::ALL_TESTS_PASSED) {
+            opcodes_passed++;
+        }
+        if (opcode_result.cached) {
+            opcodes_cached++;
+        }
+        else if (cache.has_value() && !opcode_result.cache_key.empty() && opcode_result.crash_signal == 0) {
+            const bool passed = opcode_result.result == JSONTestHarness::Result::ALL_TESTS_PASSED;
+            cache->store(opcode_result.opcode, ResultCache::Entry{opcode_result.cache_key, opcode_result.test_file, passed, opcode_result.summary});
+        }
+        results_.push_back(std::move(opcode_result));
+    }
+    if (options_.harness.quiet) {
+        out << opcodes_passed << "/" << opcodes.size() << " opcodes passed";
+        out << (cache.has_value() ? " (" + std::to_string(opcodes_cached) + " from cache)\n" : "\n");
+    }
+    if (cache.has_value() && !cache->save()) {
+        out << "Unable to write " << options_.cache_path << "\n";
+    }
+    out.flush();
+
+    return opcodes_passed == opcodes.size();
+}
+
+size_t ConformanceRunner::runWorkerThreads(const std::vector<uint8_t>& opcodes, std::vector<std::optional<OpcodeResult>>& results, const ResultCache* cache, std::ostream& out) const {
+    // Verbose runs do not start opcodes after the first failure, the ones before it still finish so the report matches a serial run
+    const bool stop_at_first_failure = !options_.harness.quiet;
+    std::atomic<size_t> next_index{0};
+    std::atomic<size_t> first_failed_index{std::numeric_limits<size_t>::max()};
+    std::mutex report_mutex;
+    size_t next_to_report = 0;
+
+    auto worker = [&]() {
+        while (true) {
+            const size_t index = next_index.fetch_add(1);
+            if (index >= opcodes.size()) return;
+            if (stop_at_first_failure && index > first_failed_index.load()) return;
+
+            OpcodeResult opcode_result = testOpcode(opcodes[index], cache);
+            if (opcode_result.result != JSONTestHarness::Result::ALL_TESTS_PASSED) {
+                size_t current = first_failed_index.load();
+                while (index < current && !first_failed_index.compare_exchange_weak(current, index)) {}
+            }
+
+            // Flush every finished result that is next in opcode order
+            std::lock_guard<std::mutex> lock(report_mutex);
+            results[index] = std::move(opcode_result);
+            while (next_to_report < results.size() && results[next_to_report].has_value()) {
+                if (stop_at_first_failure && next_to_report > first_failed_index.load()) break;
+                out << results[next_to_report]->log;
+                results[next_to_report]->log.clear();
+                next_to_report++;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const unsigned int worker_count = std::min<size_t>(jobs_, opcodes.size());
+    for (unsigned int i = 0; i < worker_count; i++) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& worker_thread : workers) {
+        worker_thread.join();
+    }
+    return next_to_report;
+}
+
+// One slot per opcode in the table shared between the parent and the worker processes
+struct ShardSlot {
+    enum State : uint32_t {
+        PENDING,
+        RUNNING,
+        DONE,
+        CRASHED,
+    };
+    std::atomic<uint32_t> state;
+    uint32_t attempts;
+    int32_t crash_signal;
+    bool cached;
+    bool passed;
+    uint32_t tests_run;
+    uint32_t tests_passed;
+    int64_t first_failure_index;
+    char first_failure_name[64];
+    char first_failure_diff[4096];
+    char cache_key[32];
+    uint64_t file_size;
+    int64_t file_mtime;
+    char file_hash[32];
+};
+
+// Copies text into a fixed size shared buffer, truncating if needed
+template <size_t N>
+static void copy_to_slot(char (&destination)[N], const std::string& text) {
+    const size_t length = std::min(text.size(), N - 1);
+    std::memcpy(destination, text.data(), length);
+    destination[length] = '\0';
+}
+
+size_t ConformanceRunner::runWorkerProcesses(const std::vector<uint8_t>& opcodes, std::vector<std::optional<OpcodeResult>>& results, const ResultCache* cache, std::ostream& out) const {
+    const size_t table_size = sizeof(ShardSlot) * opcodes.size();
+    void* mapping = mmap(nullptr, table_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        out << "Unable to map the shared result table, running on threads instead\n";
+        return runWorkerThreads(opcodes, results, cache, out);
+    }
+    ShardSlot* slots = static_cast<ShardSlot*>(mapping);
+    for (size_t index = 0; index < opcodes.size(); index++) {
+        new (&slots[index]) ShardSlot{};
+        slots[index].state.store(ShardSlot::PENDING);
+    }
+
+    auto run_shard = [&](const std::vector<size_t>& shard) {
+        for (const size_t& index : shard) {
+            ShardSlot& slot = slots[index];
+            slot.state.store(ShardSlot::RUNNING);
+            const OpcodeResult opcode_result = testOpcode(opcodes[index], cache);
+            slot.cached = opcode_result.cached;
+            slot.passed = opcode_result.result == JSONTestHarness::Result::ALL_TESTS_PASSED;
+            slot.tests_run = opcode_result.summary.tests_run;
+            slot.tests_passed = opcode_result.summary.tests_passed;
+            slot.first_failure_index = opcode_result.summary.first_failure_index.has_value() ? static_cast<int64_t>(*opcode_result.summary.first_failure_index) : -1;
+            copy_to_slot(slot.first_failure_name, opcode_result.summary.first_failure_name);
+            copy_to_slot(slot.first_failure_diff, opcode_result.summary.first_failure_diff);
+            copy_to_slot(slot.cache_key, opcode_result.cache_key);
+            slot.file_size = opcode_result.test_file.file_size;
+            slot.file_mtime = opcode_result.test_file.file_mtime;
+            copy_to_slot(slot.file_hash, opcode_result.test_file.hash);
+            slot.state.store(ShardSlot::DONE);
+        }
+    };
+
+    // Every round splits the pending opcodes into contiguous ranges, one per worker process
+    //   An opcode that was running when its worker died is retried once in a later round, then reported as crashed
+    out.flush();
+    while (true) {
+        std::vector<size_t> pending;
+        for (size_t index = 0; index < opcodes.size(); index++) {
+            if (slots[index].state.load() == ShardSlot::PENDING) pending.push_back(index);
+        }
+        if (pending.empty()) break;
+
+        const size_t shard_count = std::min<size_t>(options_.processes, pending.size());
+        std::vector<std::pair<pid_t, std::vector<size_t>>> shards;
+        for (size_t shard_index = 0; shard_index < shard_count; shard_index++) {
+            const size_t shard_begin = pending.size() * shard_index / shard_count;
+            const size_t shard_end = pending.size() * (shard_index + 1) / shard_count;
+            std::vector<size_t> shard(pending.begin() + shard_begin, pending.begin() + shard_end);
+
+            const pid_t pid = fork();
+            if (pid == 0) {
+                run_shard(shard);
+                // Skip destructors and stream flushes inherited from the parent
+                _exit(0);
+            }
+            if (pid < 0) {
+                // Could not fork, run the shard in this process
+                run_shard(shard);
+                continue;
+            }
+            shards.emplace_back(pid, std::move(shard));
+        }
+
+        for (const auto& [pid, shard] : shards) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            const bool crashed = WIFSIGNALED(status) || (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+            if (!crashed) continue;
+            for (const size_t& index : shard) {
+                ShardSlot& slot = slots[index];
+                if (slot.state.load() != ShardSlot::RUNNING) continue;
+                slot.attempts++;
+                slot.crash_signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+                slot.state.store(slot.attempts < 2 ? ShardSlot::PENDING : ShardSlot::CRASHED);
+            }
+        }
+    }
+
+    for (size_t index = 0; index < opcodes.size(); index++) {
+        const ShardSlot& slot = slots[index];
+        OpcodeResult opcode_result{opcodes[index], JSONTestHarness::Result::TEST_FAILED, {0, 0, std::nullopt, "", "", {}}, "", false, "", {0, 0, ""}, 0};
+        if (slot.state.load() == ShardSlot::CRASHED) {
+            opcode_result.crash_signal = slot.crash_signal;
+            opcode_result.summary.first_failure_diff = std::string("Worker process crashed twice (") + (slot.crash_signal != 0 ? strsignal(slot.crash_signal) : "nonzero exit") + ")\n";
+            out << uint8_to_hex_string(opcodes[index]) << " " << MOS6502::instruction_lookup_table.at(opcodes[index]).name << ": " << opcode_result.summary.first_failure_diff;
+        }
+        else {
+            opcode_result.result = slot.passed ? JSONTestHarness::Result::ALL_TESTS_PASSED : JSONTestHarness::Result::TEST_FAILED;
+            opcode_result.cached = slot.cached;
+            opcode_result.summary.tests_run = slot.tests_run;
+            opcode_result.summary.tests_passed = slot.tests_passed;
+            if (slot.first_failure_index >= 0) {
+                opcode_result.summary.first_failure_index = slot.first_failure_index;
+                opcode_result.summary.first_failure_name = slot.first_failure_name;
+                opcode_result.summary.first_failure_diff = slot.first_failure_diff;
+            }
+            opcode_result.cache_key = slot.cache_key;
+            opcode_result.test_file = ResultCache::FileHash{slot.file_size, slot.file_mtime, slot.file_hash};
+            writeOpcodeSummary(out, opcode_result);
+        }
+        results[index] = std::move(opcode_result);
+    }
+
+    munmap(mapping, table_size);
+    return opcodes.size();
+}
+
+bool ConformanceRunner::writeResults(const std::string& file_path) const {
+    std::ofstream results_file(file_path, std::ios::trunc);
+    for (const OpcodeResult& opcode_result : results_) {
+        json result_line = {
+            {"opcode", uint8_to_hex_string(opcode_result.opcode)},
+            {"name", MOS6502::instruction_lookup_table.at(opcode_result.opcode).name},
+            {"passed", opcode_result.result == JSONTestHarness::Result::ALL_TESTS_PASSED},
+            {"tests_run", opcode_result.summary.tests_run},
+            {"tests_passed", opcode_result.summary.tests_passed},
+            {"crash_signal", opcode_result.crash_signal},
+            {"first_failure", nullptr},
+        };
+        if (opcode_result.summary.first_failure_index.has_value()) {
+            result_line["first_failure"] = {
+                {"index", *opcode_result.summary.first_failure_index},
+                {"name", opcode_result.summary.first_failure_name},
+                {"diff", opcode_result.summary.first_failure_diff},
+            };
+        }
+        results_file << result_line.dump() << "\n";
+    }
+    return static_cast<bool>(results_file);
+}
+
+void ConformanceRunner::writeBenchmarkReport(std::ostream& out) const {
+    std::map<std::string_view, std::vector<uint32_t>> addressing_mode_times;
+
+    write_timing_header(out, "Opcode");
+    for (const OpcodeResult& opcode_result : results_) {
+        std::vector<uint32_t> opcode_times = opcode_result.summary.instruction_times_ns;
+        const std::string_view addressing_mode = MOS6502::getAddressingModeName(opcode_result.opcode);
+        std::vector<uint32_t>& mode_times = addressing_mode_times[addressing_mode];
+        mode_times.insert(mode_times.end(), opcode_times.begin(), opcode_times.end());
+
+        const std::string label = uint8_to_hex_string(opcode_result.opcode) + " " + std::string(MOS6502::instruction_lookup_table.at(opcode_result.opcode).name) + " " + std::string(addressing_mode);
+        write_timing_row(out, label, opcode_times);
+    }
+
+    out << "\n";
+    write_timing_header(out, "Mode");
+    for (auto& [addressing_mode, mode_times] : addressing_mode_times) {
+        write_timing_row(out, std::string(addressing_mode), mode_times);
+    }
+    out.flush();
+}
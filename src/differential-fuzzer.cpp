@@ -0,0 +1,249 @@
+#include "differential-fuzzer.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+// Project Includes
+#include "lockstep-runner.hpp"
+#include "conformance-runner.hpp"
+
+static const ExecutionEngine& engine_by_name(const std::string& name) {
+    const ExecutionEngine* engine = findExecutionEngine(name);
+    if (engine == nullptr) {
+        throw std::runtime_error("Unknown execution engine " + name);
+    }
+    return *engine;
+}
+
+static json state_to_json(const MOS6502::State& state, const std::map<uint16_t, uint8_t>& ram) {
+    json ram_json = json::array();
+    for (const auto& [address, value] : ram) {
+        ram_json.push_back({address, value});
+    }
+    return json{
+        {"pc", state.program_counter}, {"s", state.stack_ptr}, {"a", state.accumulator},
+        {"x", state.x_reg}, {"y", state.y_reg}, {"p", state.processor_status}, {"ram", ram_json},
+    };
+}
+
+static MemoryUnit sparse_image(const std::map<uint16_t, uint8_t>& ram) {
+    MemoryUnit image(65536);
+    for (const auto& [address, value] : ram) {
+        image.write(address, value);
+    }
+    return image;
+}
+
+DifferentialFuzzer::DifferentialFuzzer(const FuzzOptions& options):
+    options_{options}, reference_engine_{engine_by_name(options.reference_engine)}, candidate_engine_{engine_by_name(options.candidate_engine)},
+    jobs_{options.jobs > 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency())} {}
+
+std::vector<DifferentialFuzzer::Mismatch> DifferentialFuzzer::run(std::ostream& out) {
+    std::atomic<uint64_t> next_case{0};
+    std::atomic<uint64_t> mismatch_count{0};
+    std::mutex mismatches_mutex;
+    std::vector<Mismatch> mismatches;
+
+    auto worker = [&]() {
+        for (uint64_t case_index = next_case++; case_index < options_.cases; case_index = next_case++) {
+            // Stop handing out cases once enough mismatches are known, every case before the last one claimed still completes
+            if (mismatch_count >= options_.max_mismatches) break;
+            Mismatch mismatch;
+            if (!runCase(case_index, mismatch)) continue;
+            mismatch_count++;
+            std::lock_guard<std::mutex> lock(mismatches_mutex);
+            mismatches.push_back(std::move(mismatch));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < jobs_; i++) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    // Keep the lowest case indices so the report does not depend on thread scheduling
+    std::sort(mismatches.begin(), mismatches.end(), [](const Mismatch& lhs, const Mismatch& rhs) {
+        return lhs.case_index < rhs.case_index;
+    });
+    if (mismatches.size() > options_.max_mismatches) {
+        mismatches.resize(options_.max_mismatches);
+    }
+
+    const uint64_t cases_run = std::min(options_.cases, next_case.load());
+    out << "Ran " << cases_run << " cases of " << options_.instructions_per_case << " instructions on " << jobs_ << " threads (seed " << options_.seed << ")\n";
+    out << reference_engine_.name << " vs " << candidate_engine_.name << ": " << mismatches.size() << " mismatches\n";
+    for (const Mismatch& mismatch : mismatches) {
+        out << "  " << mismatch.test_case["name"].get<std::string>() << "\n";
+    }
+    if (!mismatches.empty()) {
+        saveMismatches(mismatches);
+        out << "Minimized test cases written to " << options_.output_directory << "\n";
+    }
+    return mismatches;
+}
+
+bool DifferentialFuzzer::runCase(const uint64_t& case_index, Mismatch& mismatch) const {
+    static const std::vector<uint8_t> official_opcodes = ConformanceRunner::officialOpcodes();
+    std::seed_seq seed_sequence{static_cast<uint32_t>(options_.seed), static_cast<uint32_t>(options_.seed >> 32),
+                                static_cast<uint32_t>(case_index), static_cast<uint32_t>(case_index >> 32)};
+    std::mt19937_64 random_engine(seed_sequence);
+
+    MemoryUnit image(65536);
+    for (uint32_t address = 0; address < 65536; address += 8) {
+        const uint64_t random_bytes = random_engine();
+        for (uint32_t i = 0; i < 8; i++) {
+            image.write(address + i, random_bytes >> (i * 8));
+        }
+    }
+
+    const uint64_t random_registers = random_engine();
+    const MOS6502::State initial_state{
+        static_cast<uint16_t>(random_registers), static_cast<uint8_t>(random_registers >> 16), static_cast<uint8_t>(random_registers >> 24),
+        static_cast<uint8_t>(random_registers >> 32), static_cast<uint8_t>(random_registers >> 40),
+        static_cast<uint8_t>((random_registers >> 48) | 0b00100000),
+    };
+
+    // Lay a stream of official opcodes with random operands at PC, branches and jumps leave it for random memory
+    uint16_t stream_address = initial_state.program_counter;
+    for (uint32_t i = 0; i < options_.instructions_per_case; i++) {
+        const uint8_t opcode = official_opcodes[random_engine() % official_opcodes.size()];
+        image.write(stream_address++, opcode);
+        for (uint8_t operand = 1; operand < MOS6502::getInstructionLength(opcode); operand++) {
+            image.write(stream_address++, random_engine());
+        }
+    }
+
+    LockstepRunner lockstep_runner{image, reference_engine_, candidate_engine_, initial_state};
+    const std::optional<LockstepRunner::Divergence> divergence = lockstep_runner.run(options_.instructions_per_case, 1);
+    if (!divergence.has_value()) {
+        return false;
+    }
+
+    // Replay up to the mismatching instruction to capture the machine right before it
+    LockstepRunner replay{image, reference_engine_, candidate_engine_, initial_state};
+    replay.run(divergence->last_instruction, 1);
+    const LockstepRunner::Machine& machine = replay.getReferenceMachine();
+    const MOS6502::State state = machine.cpu.getState();
+
+    mismatch.case_index = case_index;
+    mismatch.opcode = machine.ram.read(state.program_counter);
+    std::stringstream name;
+    name << std::hex << std::setw(2) << std::setfill('0') << unsigned(mismatch.opcode) << std::dec << " fuzz " << options_.seed << ":" << case_index;
+    mismatch.test_case = minimize(machine.ram, state, name.str());
+    return true;
+}
+
+DifferentialFuzzer::StepResult DifferentialFuzzer::step(const ExecutionEngine& engine, const MemoryUnit& image, const MOS6502::State& state) {
+    LockstepRunner::Machine machine(image);
+    engine.prepare(machine.cpu);
+    machine.cpu.setState(state);
+    machine.bus.setActivityRecorder(&machine.bus_activity);
+    const uint64_t start_cycles = machine.cpu.getCyclesElapsed();
+    engine.stepInstruction(machine.cpu);
+    machine.bus.setActivityRecorder(nullptr);
+
+    StepResult result{machine.cpu.getState(), machine.cpu.getCyclesElapsed() - start_cycles, std::move(machine.bus_activity), {}};
+    std::set<uint16_t> touched_addresses;
+    for (const BUS::Activity& activity : result.bus_activity) {
+        touched_addresses.insert(activity.address);
+    }
+    for (const uint16_t& address : touched_addresses) {
+        result.touched_memory.emplace_back(address, machine.ram.read(address));
+    }
+    return result;
+}
+
+bool DifferentialFuzzer::differs(const StepResult& reference, const StepResult& candidate) {
+    return reference.state != candidate.state || reference.cycles != candidate.cycles ||
+           LockstepRunner::memoryWrites(reference.bus_activity) != LockstepRunner::memoryWrites(candidate.bus_activity);
+}
+
+json DifferentialFuzzer::minimize(const MemoryUnit& image, MOS6502::State state, const std::string& name) const {
+    // A test case only lists the memory it touches, everything else reads as zero in the harness
+    std::map<uint16_t, uint8_t> ram;
+    for (const StepResult& result : {step(reference_engine_, image, state), step(candidate_engine_, image, state)}) {
+        for (const auto& [address, value] : result.touched_memory) {
+            ram[address] = image.read(address);
+        }
+    }
+    auto reproduces = [this](const std::map<uint16_t, uint8_t>& candidate_ram, const MOS6502::State& candidate_state) {
+        const MemoryUnit candidate_image = sparse_image(candidate_ram);
+        return differs(step(reference_engine_, candidate_image, candidate_state), step(candidate_engine_, candidate_image, candidate_state));
+    };
+
+    if (reproduces(ram, state)) {
+        for (uint8_t MOS6502::State::* reg : {&MOS6502::State::accumulator, &MOS6502::State::x_reg, &MOS6502::State::y_reg,
+                                              &MOS6502::State::stack_ptr, &MOS6502::State::processor_status}) {
+            MOS6502::State reduced_state = state;
+            reduced_state.*reg = 0;
+            if (state.*reg != 0 && reproduces(ram, reduced_state)) {
+                state = reduced_state;
+            }
+        }
+        for (auto& [address, value] : ram) {
+            if (address == state.program_counter || value == 0) continue;
+            const uint8_t original_value = std::exchange(value, 0);
+            if (!reproduces(ram, state)) {
+                value = original_value;
+            }
+        }
+    }
+
+    // Zeroed pointers may move the instruction to other addresses, so list exactly what it touches now
+    const MemoryUnit final_image = sparse_image(ram);
+    const StepResult reference = step(reference_engine_, final_image, state);
+    const StepResult candidate = step(candidate_engine_, final_image, state);
+    std::map<uint16_t, uint8_t> initial_ram;
+    std::map<uint16_t, uint8_t> final_ram;
+    for (const StepResult* result : {&candidate, &reference}) {
+        for (const auto& [address, value] : result->touched_memory) {
+            initial_ram[address] = final_image.read(address);
+            final_ram[address] = final_image.read(address);
+        }
+    }
+    for (const auto& [address, value] : reference.touched_memory) {
+        final_ram[address] = value;
+    }
+
+    json cycles = json::array();
+    for (const BUS::Activity& activity : reference.bus_activity) {
+        cycles.push_back({activity.address, activity.data, activity.type == BUS::Activity::Type::WRITE ? "write" : "read"});
+    }
+    return json{
+        {"name", name},
+        {"initial", state_to_json(state, initial_ram)},
+        {"final", state_to_json(reference.state, final_ram)},
+        {"cycles", cycles},
+    };
+}
+
+void DifferentialFuzzer::saveMismatches(const std::vector<Mismatch>& mismatches) const {
+    std::map<uint8_t, json> tests_by_opcode;
+    for (const Mismatch& mismatch : mismatches) {
+        auto [tests, inserted] = tests_by_opcode.try_emplace(mismatch.opcode, json::array());
+        tests->second.push_back(mismatch.test_case);
+    }
+
+    std::filesystem::create_directories(options_.output_directory);
+    for (const auto& [opcode, tests] : tests_by_opcode) {
+        std::stringstream file_name;
+        file_name << std::hex << std::setw(2) << std::setfill('0') << unsigned(opcode) << ".json";
+        const std::string file_path = (std::filesystem::path(options_.output_directory) / file_name.str()).string();
+        std::ofstream file_out(file_path, std::ios::trunc);
+        file_out << tests.dump(1) << "\n";
+        if (!file_out) {
+            throw std::runtime_error("Unable to write " + file_path);
+        }
+    }
+}
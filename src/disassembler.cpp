@@ -0,0 +1,52 @@
+#include "disassembler.hpp"
+// Standard Library Includes
+#include <cstdio>
+// Project Includes
+#include "mos6502.hpp"
+
+std::string disassembleInstruction(const MemoryUnit& memory, const uint16_t& address) {
+    const uint8_t opcode = memory.read(address);
+    const MOS6502::Instruction& instruction = MOS6502::instruction_lookup_table[opcode];
+    const uint8_t low_byte = memory.read(address + 1);
+    const uint16_t word = (memory.read(address + 2) << 8) | low_byte;
+
+    char operand[16] = {};
+    switch (instruction.addressing_mode) {
+        case MOS6502::AddressingMode::IMP:
+            break;
+        case MOS6502::AddressingMode::IMM:
+            std::snprintf(operand, sizeof(operand), " #$%02X", low_byte);
+            break;
+        case MOS6502::AddressingMode::ZP0:
+            std::snprintf(operand, sizeof(operand), " $%02X", low_byte);
+            break;
+        case MOS6502::AddressingMode::ZPX:
+            std::snprintf(operand, sizeof(operand), " $%02X,X", low_byte);
+            break;
+        case MOS6502::AddressingMode::ZPY:
+            std::snprintf(operand, sizeof(operand), " $%02X,Y", low_byte);
+            break;
+        case MOS6502::AddressingMode::REL:
+            std::snprintf(operand, sizeof(operand), " $%04X", static_cast<uint16_t>(address + 2 + static_cast<int8_t>(low_byte)));
+            break;
+        case MOS6502::AddressingMode::ABS:
+            std::snprintf(operand, sizeof(operand), " $%04X", word);
+            break;
+        case MOS6502::AddressingMode::ABX:
+            std::snprintf(operand, sizeof(operand), " $%04X,X", word);
+            break;
+        case MOS6502::AddressingMode::ABY:
+            std::snprintf(operand, sizeof(operand), " $%04X,Y", word);
+            break;
+        case MOS6502::AddressingMode::IND:
+            std::snprintf(operand, sizeof(operand), " ($%04X)", word);
+            break;
+        case MOS6502::AddressingMode::IZX:
+            std::snprintf(operand, sizeof(operand), " ($%02X,X)", low_byte);
+            break;
+        case MOS6502::AddressingMode::IZY:
+            std::snprintf(operand, sizeof(operand), " ($%02X),Y", low_byte);
+            break;
+    }
+    return std::string(instruction.name) + operand;
+}
@@ -0,0 +1,34 @@
+#include "execution-engine.hpp"
+
+static void prepare_instruction_stepped(MOS6502& cpu) {}
+
+static void step_instruction_stepped(MOS6502& cpu) {
+    cpu.runInstruction();
+}
+
+static void prepare_cycle_stepped(MOS6502& cpu) {
+    // Drain the cycles left by reset so the next runCycle fetches an instruction
+    while (cpu.getInstructionCyclesRemaining() > 0) {
+        cpu.runCycle();
+    }
+}
+
+static void step_cycle_stepped(MOS6502& cpu) {
+    // The first cycle fetches and executes the instruction, the rest only burn its remaining cycles
+    cpu.runCycle();
+    while (cpu.getInstructionCyclesRemaining() > 0) {
+        cpu.runCycle();
+    }
+}
+
+const std::array<ExecutionEngine, 2> execution_engines = {{
+    { "instruction", prepare_instruction_stepped, step_instruction_stepped },
+    { "cycle", prepare_cycle_stepped, step_cycle_stepped },
+}};
+
+const ExecutionEngine* findExecutionEngine(const std::string_view& name) {
+    for (const ExecutionEngine& engine : execution_engines) {
+        if (engine.name == name) return &engine;
+    }
+    return nullptr;
+}
@@ -0,0 +1,236 @@
+#include "isa-coverage.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+// Project Includes
+#include "bus.hpp"
+
+#define FLAG_NEGATIVE 0x80
+#define FLAG_OVERFLOW 0x40
+#define FLAG_ZERO 0x02
+#define FLAG_CARRY 0x01
+
+static bool is_named(const uint8_t& opcode) {
+    return MOS6502::instruction_lookup_table[opcode].name != "???";
+}
+
+static bool is_indexed(const uint8_t& opcode) {
+    const MOS6502::AddressingMode addressing_mode = MOS6502::instruction_lookup_table[opcode].addressing_mode;
+    return addressing_mode == MOS6502::AddressingMode::ABX || addressing_mode == MOS6502::AddressingMode::ABY || addressing_mode == MOS6502::AddressingMode::IZY;
+}
+
+static bool is_branch(const uint8_t& opcode) {
+    return MOS6502::instruction_lookup_table[opcode].addressing_mode == MOS6502::AddressingMode::REL;
+}
+
+static bool is_arithmetic(const uint8_t& opcode) {
+    const MOS6502::Operation operation = MOS6502::instruction_lookup_table[opcode].operation;
+    return operation == MOS6502::Operation::ADC || operation == MOS6502::Operation::SBC;
+}
+
+static bool is_compare(const uint8_t& opcode) {
+    const MOS6502::Operation operation = MOS6502::instruction_lookup_table[opcode].operation;
+    return operation == MOS6502::Operation::CMP || operation == MOS6502::Operation::CPX || operation == MOS6502::Operation::CPY;
+}
+
+static uint8_t flag_index(const bool& negative, const bool& overflow, const bool& zero, const bool& carry) {
+    return (negative << 3) | (overflow << 2) | (zero << 1) | carry;
+}
+
+static std::string flag_name(const uint8_t& index, const bool& has_overflow) {
+    std::string name = "N=" + std::to_string((index >> 3) & 1);
+    if (has_overflow) name += " V=" + std::to_string((index >> 2) & 1);
+    return name + " Z=" + std::to_string((index >> 1) & 1) + " C=" + std::to_string(index & 1);
+}
+
+static std::string opcode_name(const uint8_t& opcode) {
+    std::ostringstream name;
+    name << "$" << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << static_cast<uint16_t>(opcode) << " ";
+    name << MOS6502::instruction_lookup_table[opcode].name << " " << MOS6502::getAddressingModeName(opcode);
+    return name.str();
+}
+
+ISACoverage::ISACoverage(const BUS& bus):
+    bus_{bus}, coverage_{} {}
+
+void ISACoverage::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    OpcodeCoverage& coverage = coverage_[opcode];
+    coverage.executions++;
+    const MOS6502::Instruction& instruction = MOS6502::instruction_lookup_table[opcode];
+    const MOS6502::State state = cpu.getState();
+
+    if (instruction.addressing_mode == MOS6502::AddressingMode::REL) {
+        const uint16_t next_address = address + 2;
+        if (state.program_counter == next_address) {
+            coverage.branches_not_taken++;
+        }
+        else if ((state.program_counter & 0xFF00) == (next_address & 0xFF00)) {
+            coverage.same_page++;
+        }
+        else {
+            coverage.page_crosses++;
+        }
+    }
+    else if (is_indexed(opcode)) {
+        // The index registers are never the ones these instructions load, so they still hold the index
+        uint16_t base_address;
+        uint8_t index = state.y_reg;
+        if (instruction.addressing_mode == MOS6502::AddressingMode::IZY) {
+            const uint8_t pointer = bus_.peekBusData(address + 1);
+            base_address = bus_.peekBusData(pointer) | (bus_.peekBusData(static_cast<uint8_t>(pointer + 1)) << 8);
+        }
+        else {
+            base_address = bus_.peekBusData(address + 1) | (bus_.peekBusData(address + 2) << 8);
+            if (instruction.addressing_mode == MOS6502::AddressingMode::ABX) index = state.x_reg;
+        }
+        if (((base_address + index) & 0xFF00) == (base_address & 0xFF00)) {
+            coverage.same_page++;
+        }
+        else {
+            coverage.page_crosses++;
+        }
+    }
+
+    if (is_arithmetic(opcode) || is_compare(opcode)) {
+        const uint8_t status = state.processor_status;
+        // CMP, CPX and CPY leave V alone, so it is not part of their result
+        const bool overflow = is_arithmetic(opcode) && (status & FLAG_OVERFLOW);
+        coverage.flag_results[flag_index(status & FLAG_NEGATIVE, overflow, status & FLAG_ZERO, status & FLAG_CARRY)]++;
+    }
+}
+
+const std::array<ISACoverage::OpcodeCoverage, MOS6502_NUMBER_OF_INSTRUCTIONS>& ISACoverage::getOpcodeCoverage() const {
+    return coverage_;
+}
+
+const std::array<bool, 16>& ISACoverage::reachableFlagResults(const uint8_t& opcode) {
+    // Every accumulator, operand and carry in, with the same flag rules as MOS6502::ADC and MOS6502::CMP
+    //   SBC is ADC of the inverted operand, so it reaches the same combinations
+    static const std::array<std::array<bool, 16>, 3> reachable = [] {
+        std::array<std::array<bool, 16>, 3> results{};
+        for (uint16_t accumulator = 0; accumulator < 256; accumulator++) {
+            for (uint16_t operand = 0; operand < 256; operand++) {
+                for (uint16_t carry = 0; carry < 2; carry++) {
+                    const uint16_t sum = accumulator + operand + carry;
+                    const bool overflow = (~(accumulator ^ operand) & (accumulator ^ sum)) & 0x80;
+                    results[1][flag_index(sum & 0x80, overflow, (sum & 0xFF) == 0, sum > 0xFF)] = true;
+                }
+                const int16_t difference = accumulator - operand;
+                results[2][flag_index(difference & 0x80, false, difference == 0, difference >= 0)] = true;
+            }
+        }
+        return results;
+    }();
+    if (is_arithmetic(opcode)) return reachable[1];
+    if (is_compare(opcode)) return reachable[2];
+    return reachable[0];
+}
+
+std::vector<ISACoverage::CategoryCoverage> ISACoverage::getSummary() const {
+    std::vector<CategoryCoverage> summary = {
+        {"Opcodes", 0, 0},
+        {"Indexed page crossing", 0, 0},
+        {"Branch outcomes", 0, 0},
+        {"ADC/SBC flag results", 0, 0},
+        {"CMP/CPX/CPY flag results", 0, 0},
+    };
+    for (uint16_t opcode = 0; opcode < MOS6502_NUMBER_OF_INSTRUCTIONS; opcode++) {
+        if (!is_named(opcode)) continue;
+        const OpcodeCoverage& coverage = coverage_[opcode];
+        summary[0].covered += coverage.executions > 0;
+        summary[0].total++;
+        if (is_indexed(opcode)) {
+            summary[1].covered += (coverage.same_page > 0) + (coverage.page_crosses > 0);
+            summary[1].total += 2;
+        }
+        else if (is_branch(opcode)) {
+            summary[2].covered += (coverage.branches_not_taken > 0) + (coverage.same_page > 0) + (coverage.page_crosses > 0);
+            summary[2].total += 3;
+        }
+        if (is_arithmetic(opcode) || is_compare(opcode)) {
+            CategoryCoverage& category = summary[is_arithmetic(opcode) ? 3 : 4];
+            const std::array<bool, 16>& reachable = reachableFlagResults(opcode);
+            for (uint8_t index = 0; index < 16; index++) {
+                category.covered += reachable[index] && coverage.flag_results[index] > 0;
+                category.total += reachable[index];
+            }
+        }
+    }
+    CategoryCoverage total{"Total", 0, 0};
+    for (const CategoryCoverage& category : summary) {
+        total.covered += category.covered;
+        total.total += category.total;
+    }
+    summary.push_back(total);
+    return summary;
+}
+
+std::vector<std::string> ISACoverage::getUncovered() const {
+    std::vector<std::string> uncovered;
+    for (uint16_t opcode = 0; opcode < MOS6502_NUMBER_OF_INSTRUCTIONS; opcode++) {
+        if (!is_named(opcode)) continue;
+        const OpcodeCoverage& coverage = coverage_[opcode];
+        const std::string name = opcode_name(opcode);
+        if (coverage.executions == 0) {
+            // The finer points of an opcode that never ran are implied
+            uncovered.push_back(name + " never executed");
+            continue;
+        }
+        if (is_indexed(opcode)) {
+            if (coverage.same_page == 0) uncovered.push_back(name + " within the page");
+            if (coverage.page_crosses == 0) uncovered.push_back(name + " page cross");
+        }
+        else if (is_branch(opcode)) {
+            if (coverage.branches_not_taken == 0) uncovered.push_back(name + " not taken");
+            if (coverage.same_page == 0) uncovered.push_back(name + " taken within the page");
+            if (coverage.page_crosses == 0) uncovered.push_back(name + " taken to another page");
+        }
+        const std::array<bool, 16>& reachable = reachableFlagResults(opcode);
+        for (uint8_t index = 0; index < 16; index++) {
+            if (reachable[index] && coverage.flag_results[index] == 0) {
+                uncovered.push_back(name + " result " + flag_name(index, is_arithmetic(opcode)));
+            }
+        }
+    }
+    return uncovered;
+}
+
+void ISACoverage::writeReport(std::ostream& out, const size_t& top) const {
+    out << std::left << std::setw(28) << "Coverage" << std::right << std::setw(10) << "Covered" << std::setw(10) << "Total" << std::setw(10) << "Percent" << "\n";
+    for (const CategoryCoverage& category : getSummary()) {
+        const double percent = category.total > 0 ? 100.0 * category.covered / category.total : 0.0;
+        out << std::left << std::setw(28) << category.category << std::right << std::setw(10) << category.covered << std::setw(10) << category.total;
+        out << std::setw(9) << std::fixed << std::setprecision(2) << percent << "%" << std::defaultfloat << "\n";
+    }
+
+    const std::vector<std::string> uncovered = getUncovered();
+    if (uncovered.empty()) return;
+    out << uncovered.size() << " uncovered" << (top > 0 ? ", first ones:" : "") << "\n";
+    for (size_t i = 0; i < std::min(top, uncovered.size()); i++) {
+        out << "  " << uncovered[i] << "\n";
+    }
+}
+
+void ISACoverage::writeJSON(std::ostream& out) const {
+    out << "[";
+    bool first = true;
+    for (uint16_t opcode = 0; opcode < MOS6502_NUMBER_OF_INSTRUCTIONS; opcode++) {
+        if (!is_named(opcode)) continue;
+        const OpcodeCoverage& coverage = coverage_[opcode];
+        out << (first ? "\n" : ",\n") << "  {\"opcode\": " << opcode << ", \"name\": \"" << MOS6502::instruction_lookup_table[opcode].name;
+        out << "\", \"addressing_mode\": \"" << MOS6502::getAddressingModeName(opcode) << "\", \"executions\": " << coverage.executions;
+        out << ", \"same_page\": " << coverage.same_page << ", \"page_crosses\": " << coverage.page_crosses;
+        out << ", \"branches_not_taken\": " << coverage.branches_not_taken << ", \"flag_results\": {";
+        bool first_result = true;
+        const std::array<bool, 16>& reachable = reachableFlagResults(opcode);
+        for (uint8_t index = 0; index < 16; index++) {
+            if (!reachable[index]) continue;
+            out << (first_result ? "" : ", ") << "\"" << flag_name(index, is_arithmetic(opcode)) << "\": " << coverage.flag_results[index];
+            first_result = false;
+        }
+        out << "}}";
+        first = false;
+    }
+    out << (first ? "]" : "\n]") << std::endl;
+}
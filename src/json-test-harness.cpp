@@ -1,47 +1,174 @@
 #include "json-test-harness.hpp"
 // Standard Library Includes
-#include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 
-JSONTestHarness::JSONTestHarness(MOS6502& cpu, const std::string& file_path): instructions_tested_{0}, cpu_{cpu} {
+// Median cost of reading the clock twice, subtracted from every timed instruction
+static int64_t clock_overhead_ns() {
+    static const int64_t overhead_ns = []() {
+        std::vector<int64_t> samples(1001);
+        for (int64_t& sample : samples) {
+            const auto start_time = std::chrono::steady_clock::now();
+            const auto end_time = std::chrono::steady_clock::now();
+            sample = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+        }
+        std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+        return samples[samples.size() / 2];
+    }();
+    return overhead_ns;
+}
+
+static std::string bus_activity_string(const BUS::Activity& activity) {
+    std::ostringstream ss;
+    ss << (activity.type == BUS::Activity::Type::WRITE ? "write " : "read  ") << std::hex << std::setfill('0');
+    ss << "0x" << std::setw(4) << activity.address << " 0x" << std::setw(2) << unsigned(activity.data);
+    return ss.str();
+}
+
+static std::string cycle_entry_string(const TestCorpus::CycleEntry& cycle_entry) {
+    const BUS::Activity::Type type = cycle_entry.activity == TestCorpus::BusActivity::WRITE ? BUS::Activity::Type::WRITE : BUS::Activity::Type::READ;
+    return bus_activity_string(BUS::Activity{cycle_entry.address, cycle_entry.value, type});
+}
+
+JSONTestHarness::JSONTestHarness(MOS6502& cpu, const std::string& file_path, std::ostream& out, const HarnessOptions& options): 
+    instructions_tested_{0}, cpu_{cpu}, out_{out}, options_{options}, test_corpus_{loadTestCorpus(file_path)},
+    summary_{0, 0, std::nullopt, "", "", {}}, last_cycle_count_{0} {}
+
+TestCorpus JSONTestHarness::loadTestCorpus(const std::string& file_path) {
+    if (TestCorpus::isCorpusFile(file_path)) {
+        return TestCorpus::fromFile(file_path);
+    }
     std::ifstream json_file(file_path);
-    test_json_ = json::parse(json_file);
+    if (!json_file) {
+        throw std::runtime_error("Unable to open " + file_path);
+    }
+    return TestCorpus::fromJSON(json::parse(json_file));
 }
 
 JSONTestHarness::Result JSONTestHarness::singleInstructionStep() {
-    if (instructions_tested_ >= test_json_.size()) {
-        std::cout << "All Test Passed" << std::endl;
+    if (instructions_tested_ >= test_corpus_.size()) {
+        if (!options_.quiet) {
+            out_ << "All Test Passed" << std::endl;
+        }
         return Result::ALL_TESTS_PASSED;
     }
-    
+
+    const Result result = runCurrentTestCase();
+    if (result == Result::TEST_OK) {
+        instructions_tested_++;
+    }
+    return result;
+}
+
+JSONTestHarness::Summary JSONTestHarness::runAllTests() {
+    // Unlike singleInstructionStep, failed cases are skipped so every case gets run once
+    while (instructions_tested_ < test_corpus_.size()) {
+        runCurrentTestCase();
+        instructions_tested_++;
+    }
+    return summary_;
+}
+
+const JSONTestHarness::Summary& JSONTestHarness::getSummary() const {
+    return summary_;
+}
+
+JSONTestHarness::Result JSONTestHarness::runCurrentTestCase() {
+    const Result result = runTestCase();
+    summary_.tests_run++;
+    if (result == Result::TEST_OK) {
+        summary_.tests_passed++;
+    }
+    else if (!summary_.first_failure_index.has_value()) {
+        // Captured before the RAM is restored so the diff shows what the instruction left behind
+        std::ostringstream first_failure;
+        first_failure << "Test " << instructions_tested_ << " \"" << test_corpus_.name(instructions_tested_) << "\"\n";
+        first_failure << failure_log_.str();
+        writeStateDiff(first_failure);
+        summary_.first_failure_index = instructions_tested_;
+        summary_.first_failure_name = test_corpus_.name(instructions_tested_);
+        summary_.first_failure_diff = first_failure.str();
+    }
+    if (result != Result::TEST_OK && !options_.quiet) {
+        out_ << failure_log_.str() << std::flush;
+    }
+    failure_log_.str("");
+
+    // Undo this case's memory writes so the next case starts from a clean RAM
+    restoreTouchedMemory();
+    return result;
+}
+
+void JSONTestHarness::recordTouchedMemory(const std::span<const TestCorpus::RAMEntry>& ram_entries) {
+    for (const TestCorpus::RAMEntry& address_value_pair : ram_entries) {
+        touched_memory_.push_back(TestCorpus::RAMEntry{address_value_pair.address, cpu_.readMemory(address_value_pair.address), 0});
+    }
+}
+
+void JSONTestHarness::restoreTouchedMemory() {
+    // Restoring in reverse order leaves each address with the value it had before its first write
+    for (auto it = touched_memory_.rbegin(); it != touched_memory_.rend(); it++) {
+        cpu_.writeMemory(it->address, it->value);
+    }
+    touched_memory_.clear();
+}
+
+JSONTestHarness::Result JSONTestHarness::runTestCase() {
     const uint64_t old_cycle = cpu_.getCyclesElapsed();
 
-    const auto& cur_instruction_test = test_json_[instructions_tested_];
-    const auto& cur_instruction_test_initial = cur_instruction_test["initial"];
-    const auto& cur_instruction_test_final = cur_instruction_test["final"];
+    const TestCorpus::TestRecord& cur_instruction_test = test_corpus_.record(instructions_tested_);
+    const TestCorpus::State& cur_instruction_test_initial = cur_instruction_test.initial;
+    const TestCorpus::State& cur_instruction_test_final = cur_instruction_test.final;
     
     // Sets the initial state of the CPU
     const MOS6502::State initial_state = {
-        cur_instruction_test_initial["pc"],
-        cur_instruction_test_initial["s"],
-        cur_instruction_test_initial["a"],
-        cur_instruction_test_initial["x"],
-        cur_instruction_test_initial["y"],
-        cur_instruction_test_initial["p"]
+        cur_instruction_test_initial.program_counter,
+        cur_instruction_test_initial.stack_ptr,
+        cur_instruction_test_initial.accumulator,
+        cur_instruction_test_initial.x_reg,
+        cur_instruction_test_initial.y_reg,
+        cur_instruction_test_initial.processor_status
     };
     cpu_.setState(initial_state);
 
+    // Every address the instruction can write appears in the final RAM, so saving those and the initial RAM covers the whole case
+    recordTouchedMemory(test_corpus_.initialRAM(instructions_tested_));
+    recordTouchedMemory(test_corpus_.finalRAM(instructions_tested_));
+
     // Sets the initial state of the Memory
-    for (const auto& address_value_pair : cur_instruction_test_initial["ram"]) {
-        cpu_.writeMemory(address_value_pair[0], address_value_pair[1]);
+    for (const TestCorpus::RAMEntry& address_value_pair : test_corpus_.initialRAM(instructions_tested_)) {
+        cpu_.writeMemory(address_value_pair.address, address_value_pair.value);
     }
 
-    cpu_.runInstruction();
-    std::cout << "Executed Instruction " << cur_instruction_test["name"] << std::endl;
+    BUS* bus = cpu_.getConnectedBUS();
+    if (options_.verify_bus) {
+        bus_activity_.clear();
+        bus->setActivityRecorder(&bus_activity_);
+    }
+    if (options_.time_instructions) {
+        const auto start_time = std::chrono::steady_clock::now();
+        cpu_.runInstruction();
+        const auto end_time = std::chrono::steady_clock::now();
+        const int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() - clock_overhead_ns();
+        summary_.instruction_times_ns.push_back(std::max<int64_t>(elapsed_ns, 0));
+    }
+    else {
+        cpu_.runInstruction();
+    }
+    if (options_.verify_bus) {
+        bus->setActivityRecorder(nullptr);
+    }
+    last_cycle_count_ = cpu_.getCyclesElapsed() - old_cycle;
+    if (!options_.quiet) {
+        out_ << "Executed Instruction \"" << test_corpus_.name(instructions_tested_) << "\"" << std::endl;
+    }
 
-    if (cpu_.getCyclesElapsed() - old_cycle != cur_instruction_test["cycles"].size()) {
-        std::cout << "Unexpected Cycle Count" << std::endl;
-        std::cout << "Got " << cpu_.getCyclesElapsed() - old_cycle << " Expected " << cur_instruction_test["cycles"].size() << std::endl;
+    if (last_cycle_count_ != cur_instruction_test.cycles_count) {
+        failure_log_ << "Unexpected Cycle Count" << std::endl;
+        failure_log_ << "Got " << last_cycle_count_ << " Expected " << cur_instruction_test.cycles_count << std::endl;
         return Result::TEST_FAILED;
     }
 
@@ -49,48 +176,103 @@ JSONTestHarness::Result JSONTestHarness::singleInstructionStep() {
 
     const MOS6502::State final_state = cpu_.getState();
 
-    if (final_state.program_counter != cur_instruction_test_final["pc"]) {
-        std::cout << "Unexpected Program Counter" << std::endl;
-        std::cout << "Got " << final_state.program_counter << " Expected " << cur_instruction_test_final["pc"] << std::endl;
+    if (final_state.program_counter != cur_instruction_test_final.program_counter) {
+        failure_log_ << "Unexpected Program Counter" << std::endl;
+        failure_log_ << "Got " << final_state.program_counter << " Expected " << cur_instruction_test_final.program_counter << std::endl;
         return Result::TEST_FAILED;
     }
-    if (final_state.stack_ptr != cur_instruction_test_final["s"]) {
-        std::cout << "Unexpected Stack Pointer" << std::endl;
-        std::cout << "Got " << final_state.stack_ptr << " Expected " << cur_instruction_test_final["s"] << std::endl;
+    if (final_state.stack_ptr != cur_instruction_test_final.stack_ptr) {
+        failure_log_ << "Unexpected Stack Pointer" << std::endl;
+        failure_log_ << "Got " << unsigned(final_state.stack_ptr) << " Expected " << unsigned(cur_instruction_test_final.stack_ptr) << std::endl;
         return Result::TEST_FAILED;
     }
-    if (final_state.accumulator != cur_instruction_test_final["a"]) {
-        std::cout << "Unexpected Accumulator" << std::endl;
-        std::cout << "Got " << final_state.accumulator << " Expected " << cur_instruction_test_final["a"] << std::endl;
+    if (final_state.accumulator != cur_instruction_test_final.accumulator) {
+        failure_log_ << "Unexpected Accumulator" << std::endl;
+        failure_log_ << "Got " << unsigned(final_state.accumulator) << " Expected " << unsigned(cur_instruction_test_final.accumulator) << std::endl;
         return Result::TEST_FAILED;
     }
-    if (final_state.x_reg != cur_instruction_test_final["x"]) {
-        std::cout << "Unexpected X Register" << std::endl;
-        std::cout << "Got " << final_state.x_reg << " Expected " << cur_instruction_test_final["x"] << std::endl;
+    if (final_state.x_reg != cur_instruction_test_final.x_reg) {
+        failure_log_ << "Unexpected X Register" << std::endl;
+        failure_log_ << "Got " << unsigned(final_state.x_reg) << " Expected " << unsigned(cur_instruction_test_final.x_reg) << std::endl;
         return Result::TEST_FAILED;
     }
-    if (final_state.y_reg != cur_instruction_test_final["y"]) {
-        std::cout << "Unexpected Y Register" << std::endl;
-        std::cout << "Got " << final_state.y_reg << " Expected " << cur_instruction_test_final["y"] << std::endl;
+    if (final_state.y_reg != cur_instruction_test_final.y_reg) {
+        failure_log_ << "Unexpected Y Register" << std::endl;
+        failure_log_ << "Got " << unsigned(final_state.y_reg) << " Expected " << unsigned(cur_instruction_test_final.y_reg) << std::endl;
         return Result::TEST_FAILED;
     }
-    if (final_state.processor_status != cur_instruction_test_final["p"]) {
-        std::cout << "Unexpected Processor Status" << std::endl;
-        std::cout << "Got " << final_state.processor_status << " Expected " << cur_instruction_test_final["p"] << std::endl;
+    if (final_state.processor_status != cur_instruction_test_final.processor_status) {
+        failure_log_ << "Unexpected Processor Status" << std::endl;
+        failure_log_ << "Got " << unsigned(final_state.processor_status) << " Expected " << unsigned(cur_instruction_test_final.processor_status) << std::endl;
         return Result::TEST_FAILED;
     }
     
     // ----------------------- Checking the Memory -----------------------------
 
-    for (const auto& address_value_pair : cur_instruction_test_final["ram"]) {
-        if (cpu_.readMemory(address_value_pair[0]) != address_value_pair[1]) {
-            std::cout << "Unexpected memory value at address" << address_value_pair[0] << std::endl;
-            std::cout << "Got " << cpu_.readMemory(address_value_pair[0]) << " Expected " << address_value_pair[1] << std::endl;
+    for (const TestCorpus::RAMEntry& address_value_pair : test_corpus_.finalRAM(instructions_tested_)) {
+        if (cpu_.readMemory(address_value_pair.address) != address_value_pair.value) {
+            failure_log_ << "Unexpected memory value at address " << address_value_pair.address << std::endl;
+            failure_log_ << "Got " << unsigned(cpu_.readMemory(address_value_pair.address)) << " Expected " << unsigned(address_value_pair.value) << std::endl;
             return Result::TEST_FAILED;
         }
     }
 
-    instructions_tested_++;
+    // ----------------------- Checking the Bus Activity -----------------------
+
+    if (options_.verify_bus) {
+        const std::span<const TestCorpus::CycleEntry> expected_activity = test_corpus_.cycles(instructions_tested_);
+        for (size_t cycle = 0; cycle < std::max(bus_activity_.size(), expected_activity.size()); cycle++) {
+            const bool got_access = cycle < bus_activity_.size();
+            const bool expected_access = cycle < expected_activity.size();
+            if (got_access && expected_access &&
+                bus_activity_[cycle].address == expected_activity[cycle].address &&
+                bus_activity_[cycle].data == expected_activity[cycle].value &&
+                (bus_activity_[cycle].type == BUS::Activity::Type::WRITE) == (expected_activity[cycle].activity == TestCorpus::BusActivity::WRITE)) {
+                continue;
+            }
+            failure_log_ << "Unexpected bus activity at cycle " << cycle << std::endl;
+            failure_log_ << "Got " << (got_access ? bus_activity_string(bus_activity_[cycle]) : "nothing");
+            failure_log_ << " Expected " << (expected_access ? cycle_entry_string(expected_activity[cycle]) : "nothing") << std::endl;
+            return Result::TEST_FAILED;
+        }
+    }
 
     return Result::TEST_OK;
 }
+
+void JSONTestHarness::writeStateDiff(std::ostream& out) const {
+    const TestCorpus::TestRecord& cur_instruction_test = test_corpus_.record(instructions_tested_);
+    const MOS6502::State final_state = cpu_.getState();
+
+    auto write_row = [&out](const std::string& field, const unsigned int& got, const unsigned int& expected, const int& hex_width) {
+        out << "  " << std::left << std::setw(18) << field << std::right << std::hex << std::setfill('0');
+        out << " got 0x" << std::setw(hex_width) << got << " expected 0x" << std::setw(hex_width) << expected;
+        out << std::dec << std::setfill(' ') << (got != expected ? "  <--" : "") << "\n";
+    };
+
+    write_row("Program Counter", final_state.program_counter, cur_instruction_test.final.program_counter, 4);
+    write_row("Stack Pointer", final_state.stack_ptr, cur_instruction_test.final.stack_ptr, 2);
+    write_row("Accumulator", final_state.accumulator, cur_instruction_test.final.accumulator, 2);
+    write_row("X Register", final_state.x_reg, cur_instruction_test.final.x_reg, 2);
+    write_row("Y Register", final_state.y_reg, cur_instruction_test.final.y_reg, 2);
+    write_row("Processor Status", final_state.processor_status, cur_instruction_test.final.processor_status, 2);
+    write_row("Cycles", last_cycle_count_, cur_instruction_test.cycles_count, 2);
+    for (const TestCorpus::RAMEntry& address_value_pair : test_corpus_.finalRAM(instructions_tested_)) {
+        std::ostringstream field;
+        field << "Memory 0x" << std::hex << std::setw(4) << std::setfill('0') << address_value_pair.address;
+        write_row(field.str(), cpu_.readMemory(address_value_pair.address), address_value_pair.value, 2);
+    }
+    if (options_.verify_bus) {
+        writeBusActivityDiff(out);
+    }
+}
+
+void JSONTestHarness::writeBusActivityDiff(std::ostream& out) const {
+    const std::span<const TestCorpus::CycleEntry> expected_activity = test_corpus_.cycles(instructions_tested_);
+    for (size_t cycle = 0; cycle < std::max(bus_activity_.size(), expected_activity.size()); cycle++) {
+        const std::string got = cycle < bus_activity_.size() ? bus_activity_string(bus_activity_[cycle]) : "nothing";
+        const std::string expected = cycle < expected_activity.size() ? cycle_entry_string(expected_activity[cycle]) : "nothing";
+        out << "  Cycle " << std::left << std::setw(12) << cycle;
+        out << " got " << std::setw(17) << got << " expected " << std::setw(17) << expected << std::right << (got != expected ? "  <--" : "") << "\n";
+    }
+}
@@ -0,0 +1,95 @@
+#include "lockstep-runner.hpp"
+// Standard Library Includes
+#include <iomanip>
+
+LockstepRunner::Machine::Machine(const MemoryUnit& image): cpu{}, ram{image}, bus{cpu, ram}, bus_activity{}, compared_cycles{0} {}
+
+LockstepRunner::LockstepRunner(const MemoryUnit& image, const ExecutionEngine& reference, const ExecutionEngine& candidate, const std::optional<MOS6502::State>& initial_state):
+    reference_engine_{reference}, candidate_engine_{candidate},
+    reference_{std::make_unique<Machine>(image)}, candidate_{std::make_unique<Machine>(image)},
+    instructions_executed_{0}, compared_instructions_{0} {
+    reference_engine_.prepare(reference_->cpu);
+    candidate_engine_.prepare(candidate_->cpu);
+    for (Machine* machine : {reference_.get(), candidate_.get()}) {
+        if (initial_state.has_value()) {
+            machine->cpu.setState(*initial_state);
+        }
+        // Engines may spend different cycles getting ready, only cycles from here on are compared
+        machine->compared_cycles = machine->cpu.getCyclesElapsed();
+        machine->bus.setActivityRecorder(&machine->bus_activity);
+    }
+}
+
+std::optional<LockstepRunner::Divergence> LockstepRunner::run(const uint64_t& max_instructions, const uint64_t& compare_interval) {
+    for (uint64_t i = 0; i < max_instructions; i++) {
+        reference_engine_.stepInstruction(reference_->cpu);
+        candidate_engine_.stepInstruction(candidate_->cpu);
+        instructions_executed_++;
+
+        if (instructions_executed_ % compare_interval == 0 || i + 1 == max_instructions) {
+            std::optional<Divergence> divergence = compare();
+            if (divergence.has_value()) {
+                return divergence;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<LockstepRunner::Divergence> LockstepRunner::compare() {
+    Divergence divergence{
+        compared_instructions_, instructions_executed_ - 1,
+        reference_->cpu.getState(), candidate_->cpu.getState(),
+        reference_->cpu.getCyclesElapsed() - reference_->compared_cycles,
+        candidate_->cpu.getCyclesElapsed() - candidate_->compared_cycles,
+        memoryWrites(reference_->bus_activity), memoryWrites(candidate_->bus_activity),
+    };
+
+    for (Machine* machine : {reference_.get(), candidate_.get()}) {
+        machine->bus_activity.clear();
+        machine->compared_cycles = machine->cpu.getCyclesElapsed();
+    }
+    compared_instructions_ = instructions_executed_;
+
+    if (divergence.reference_state == divergence.candidate_state &&
+        divergence.reference_cycles == divergence.candidate_cycles &&
+        divergence.reference_writes == divergence.candidate_writes) {
+        return std::nullopt;
+    }
+    return divergence;
+}
+
+uint64_t LockstepRunner::getInstructionsExecuted() const {
+    return instructions_executed_;
+}
+
+const LockstepRunner::Machine& LockstepRunner::getReferenceMachine() const {
+    return *reference_;
+}
+
+void LockstepRunner::writeDivergence(std::ostream& out, const Divergence& divergence) const {
+    out << "Engines diverged within instructions " << divergence.first_instruction << " to " << divergence.last_instruction << "\n";
+
+    auto write_machine = [&out](const ExecutionEngine& engine, const Machine& machine, const uint64_t& cycles, const std::vector<BUS::Activity>& writes) {
+        out << "---- " << engine.name << " ----\n";
+        machine.cpu.outputCurrentState(out);
+        out << "Cycles In Window: " << cycles << "\n";
+        out << "Memory Writes  :";
+        for (const BUS::Activity& write : writes) {
+            out << std::hex << std::setfill('0') << " [0x" << std::setw(4) << write.address << "]=0x" << std::setw(2) << unsigned(write.data);
+        }
+        out << std::dec << std::setfill(' ') << "\n";
+    };
+    write_machine(reference_engine_, *reference_, divergence.reference_cycles, divergence.reference_writes);
+    write_machine(candidate_engine_, *candidate_, divergence.candidate_cycles, divergence.candidate_writes);
+}
+
+std::vector<BUS::Activity> LockstepRunner::memoryWrites(const std::vector<BUS::Activity>& bus_activity) {
+    std::vector<BUS::Activity> writes;
+    for (const BUS::Activity& activity : bus_activity) {
+        if (activity.type == BUS::Activity::Type::WRITE) {
+            writes.push_back(activity);
+        }
+    }
+    return writes;
+}
@@ -1,41 +1,108 @@
 // Standard Library Headers
 #include <iostream>
-#include <sstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
 // Project Headers
-#include "bus.hpp"
-#include "mos6502.hpp"
-#include "memory-unit.hpp"
-#include "json-test-harness.hpp"
+#include "conformance-runner.hpp"
 
-static std::string uint8_to_hex_string(const uint8_t& value) {
-    std::stringstream ss;
-    ss << std::hex << std::setw(2) << std::setfill('0') << unsigned(value);
-    return ss.str();
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--tests <directory> | --corpus <directory>] [--jobs <threads> | --processes <workers>] [--quiet] [--verify-bus] [--benchmark] [--cache <file> [--force]] [--results <file>]" << std::endl;
 }
 
-int main(int argc, char *argv[]) {
-    MOS6502 cpu;
-    MemoryUnit ram(65536); // 64kB for testing
-    BUS bus(cpu, ram);
-    
-    for (unsigned int i = 0; i < MOS6502::instruction_lookup_table.size(); i++) {
-        const MOS6502::Instruction& instruction = MOS6502::instruction_lookup_table.at(i);
-        // Skip Unofficial OPCODE Tests
-        if (instruction.name == "???") continue;
+// Accepts only a plain decimal count, std::stoul alone would take "-1" or "4x" and throw on "abc"
+static bool parse_count(const std::string& text, unsigned int& count) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    try {
+        const unsigned long value = std::stoul(text);
+        if (value > std::numeric_limits<unsigned int>::max()) {
+            return false;
+        }
+        count = static_cast<unsigned int>(value);
+        return true;
+    }
+    catch (const std::out_of_range&) {
+        return false;
+    }
+}
 
-        // Download JSON tests from https://github.com/SingleStepTests/ProcessorTests/tree/main/nes6502/v1
-        //   Create a folder named "json-tests" and place all NES 6502 tests in there and run the program
-        //   Program should exit with code 0 if succeed and 1 if failed
-        JSONTestHarness json_test_harness{cpu, "json-tests/" + uint8_to_hex_string(i) + ".json"};
-        while (true) {
-            JSONTestHarness::Result step_result = json_test_harness.singleInstructionStep();
-            if (step_result == JSONTestHarness::Result::ALL_TESTS_PASSED) {
-                break;
+int main(int argc, char *argv[]) {
+    // Tests are read from JSON in "--tests <directory>" by default, "--corpus <directory>" reads the files made by json-to-corpus instead
+    ConformanceOptions options;
+    // Optional JSON lines file with one result per opcode, written once at the end
+    std::string results_path;
+    bool benchmark = false;
+    for (int arg_index = 1; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        if (arg == "--tests" && arg_index + 1 < argc) {
+            options.test_directory = argv[++arg_index];
+            options.test_extension = ".json";
+        }
+        else if (arg == "--corpus" && arg_index + 1 < argc) {
+            options.test_directory = argv[++arg_index];
+            options.test_extension = ".bin";
+        }
+        else if (arg == "--jobs" && arg_index + 1 < argc) {
+            if (!parse_count(argv[++arg_index], options.jobs)) {
+                print_usage(argv[0]);
+                return 1;
             }
-            if (step_result == JSONTestHarness::Result::TEST_FAILED) {
+        }
+        else if (arg == "--processes" && arg_index + 1 < argc) {
+            if (!parse_count(argv[++arg_index], options.processes)) {
+                print_usage(argv[0]);
                 return 1;
             }
         }
+        else if (arg == "--quiet") {
+            options.harness.quiet = true;
+        }
+        else if (arg == "--verify-bus") {
+            options.harness.verify_bus = true;
+        }
+        else if (arg == "--benchmark") {
+            // Timing is reported per opcode, so the per-test log is dropped and every opcode runs to completion
+            benchmark = true;
+            options.harness.quiet = true;
+            options.harness.time_instructions = true;
+        }
+        else if (arg == "--cache" && arg_index + 1 < argc) {
+            options.cache_path = argv[++arg_index];
+        }
+        else if (arg == "--force") {
+            options.force_full_run = true;
+        }
+        else if (arg == "--results" && arg_index + 1 < argc) {
+            results_path = argv[++arg_index];
+        }
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.processes > 0) {
+        if (benchmark) {
+            std::cerr << "--benchmark cannot be combined with --processes" << std::endl;
+            return 1;
+        }
+        // Worker processes only report summaries through shared memory
+        options.harness.quiet = true;
+    }
+
+    // Download JSON tests from https://github.com/SingleStepTests/ProcessorTests/tree/main/nes6502/v1
+    //   Create a folder named "json-tests" and place all NES 6502 tests in there and run the program
+    //   Program should exit with code 0 if succeed and 1 if failed
+    ConformanceRunner conformance_runner{options};
+    const bool all_passed = conformance_runner.run(std::cout);
+    if (benchmark) {
+        conformance_runner.writeBenchmarkReport(std::cout);
+    }
+    if (!results_path.empty() && !conformance_runner.writeResults(results_path)) {
+        std::cerr << "Unable to write " << results_path << std::endl;
+        return 1;
     }
-    return 0;
+    return all_passed ? 0 : 1;
 }
@@ -0,0 +1,126 @@
+#include "memory-heatmap.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+// Project Includes
+#include "mos6502.hpp"
+
+#define HEATMAP_ADDRESSES 65536
+#define HEATMAP_SIDE 256
+
+MemoryHeatmap::MemoryHeatmap(): reads_(HEATMAP_ADDRESSES), writes_(HEATMAP_ADDRESSES), executes_(HEATMAP_ADDRESSES), instruction_lengths_(HEATMAP_ADDRESSES) {}
+
+void MemoryHeatmap::onRead(const uint16_t& address, const uint8_t& data) {
+    reads_[address]++;
+}
+
+void MemoryHeatmap::onWrite(const uint16_t& address, const uint8_t& data) {
+    writes_[address]++;
+}
+
+void MemoryHeatmap::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    executes_[address]++;
+    instruction_lengths_[address] = MOS6502::getInstructionLength(opcode);
+}
+
+uint64_t MemoryHeatmap::getCount(const uint16_t& address, const Access& access) const {
+    switch (access) {
+        case Access::READ:
+            return reads_[address];
+        case Access::WRITE:
+            return writes_[address];
+        case Access::EXECUTE:
+            return executes_[address];
+        case Access::ALL:
+            return reads_[address] + writes_[address] + executes_[address];
+    }
+    return 0;
+}
+
+std::vector<uint8_t> MemoryHeatmap::scaledCounts(const Access& access) const {
+    uint64_t max_count = 0;
+    for (uint32_t address = 0; address < HEATMAP_ADDRESSES; address++) {
+        max_count = std::max(max_count, getCount(address, access));
+    }
+    // Counts span many orders of magnitude, a linear scale would only show the hottest loop
+    std::vector<uint8_t> scaled_counts(HEATMAP_ADDRESSES);
+    const double log_max_count = std::log1p(static_cast<double>(max_count));
+    for (uint32_t address = 0; address < HEATMAP_ADDRESSES && max_count != 0; address++) {
+        scaled_counts[address] = std::lround(std::log1p(static_cast<double>(getCount(address, access))) / log_max_count * 255);
+    }
+    return scaled_counts;
+}
+
+void MemoryHeatmap::writePGM(std::ostream& out, const Access& access) const {
+    const std::vector<uint8_t> scaled_counts = scaledCounts(access);
+    out << "P5\n" << HEATMAP_SIDE << " " << HEATMAP_SIDE << "\n255\n";
+    out.write(reinterpret_cast<const char*>(scaled_counts.data()), scaled_counts.size());
+}
+
+void MemoryHeatmap::writePPM(std::ostream& out) const {
+    const std::array<std::vector<uint8_t>, 3> channels = {scaledCounts(Access::WRITE), scaledCounts(Access::READ), scaledCounts(Access::EXECUTE)};
+    std::vector<uint8_t> pixels;
+    pixels.reserve(HEATMAP_ADDRESSES * channels.size());
+    for (uint32_t address = 0; address < HEATMAP_ADDRESSES; address++) {
+        for (const std::vector<uint8_t>& channel : channels) {
+            pixels.push_back(channel[address]);
+        }
+    }
+    out << "P6\n" << HEATMAP_SIDE << " " << HEATMAP_SIDE << "\n255\n";
+    out.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+}
+
+void MemoryHeatmap::writeCSV(std::ostream& out, const Access& access) const {
+    for (uint32_t page = 0; page < HEATMAP_SIDE; page++) {
+        for (uint32_t offset = 0; offset < HEATMAP_SIDE; offset++) {
+            out << (offset == 0 ? "" : ",") << getCount(page * HEATMAP_SIDE + offset, access);
+        }
+        out << "\n";
+    }
+}
+
+void MemoryHeatmap::writeReport(std::ostream& out, const size_t& top) const {
+    size_t read_addresses = 0, written_addresses = 0, executed_addresses = 0, touched_pages = 0;
+    for (uint32_t page = 0; page < HEATMAP_SIDE; page++) {
+        bool page_touched = false;
+        for (uint32_t address = page * HEATMAP_SIDE; address < (page + 1) * HEATMAP_SIDE; address++) {
+            read_addresses += reads_[address] != 0;
+            written_addresses += writes_[address] != 0;
+            executed_addresses += executes_[address] != 0;
+            page_touched |= getCount(address, Access::ALL) != 0;
+        }
+        touched_pages += page_touched;
+    }
+    out << "Working set: " << touched_pages << " pages, " << read_addresses << " addresses read, ";
+    out << written_addresses << " written, " << executed_addresses << " executed\n";
+
+    // Opcode and operand bytes are code, every other read or write is data
+    std::vector<bool> code(HEATMAP_ADDRESSES);
+    for (uint32_t address = 0; address < HEATMAP_ADDRESSES; address++) {
+        for (uint8_t i = 0; i < instruction_lengths_[address]; i++) {
+            code[(address + i) % HEATMAP_ADDRESSES] = true;
+        }
+    }
+    std::vector<uint16_t> zero_page_addresses, absolute_addresses;
+    for (uint32_t address = 0; address < HEATMAP_ADDRESSES; address++) {
+        if (code[address] || reads_[address] + writes_[address] == 0) continue;
+        // The stack page is accessed through the stack pointer and cannot move to zero page
+        if (address >= 0x0100 && address < 0x0200) continue;
+        (address < 0x0100 ? zero_page_addresses : absolute_addresses).push_back(address);
+    }
+    auto busiest_first = [this](const uint16_t& a, const uint16_t& b) {
+        return reads_[a] + writes_[a] != reads_[b] + writes_[b] ? reads_[a] + writes_[a] > reads_[b] + writes_[b] : a < b;
+    };
+    for (std::vector<uint16_t>* addresses : {&zero_page_addresses, &absolute_addresses}) {
+        std::sort(addresses->begin(), addresses->end(), busiest_first);
+        out << "\n" << std::left << std::setw(12) << (addresses == &zero_page_addresses ? "Zero page" : "Absolute") << std::right;
+        out << std::setw(14) << "Reads" << std::setw(14) << "Writes" << "\n";
+        for (size_t i = 0; i < std::min(top, addresses->size()); i++) {
+            const uint16_t address = (*addresses)[i];
+            out << "$" << std::hex << std::uppercase << std::setfill('0') << std::setw(address < 0x0100 ? 2 : 4) << address;
+            out << std::dec << std::nouppercase << std::setfill(' ') << std::setw(address < 0x0100 ? 9 : 7) << "";
+            out << std::setw(14) << reads_[address] << std::setw(14) << writes_[address] << "\n";
+        }
+    }
+}
@@ -1,10 +1,9 @@
 #include "memory-unit.hpp"
+// Standard Library Includes
+#include <algorithm>
 
-MemoryUnit::MemoryUnit(const uint32_t& byte_size): byte_size_(byte_size), memory_block_(std::make_unique<uint8_t[]>(byte_size)) {
-    for (uint32_t i = 0; i < byte_size_; i++) {
-        memory_block_[i] = 0x00;
-    }
-}
+// make_unique value-initializes the block, so it is already zeroed
+MemoryUnit::MemoryUnit(const uint32_t& byte_size): byte_size_(byte_size), memory_block_(std::make_unique<uint8_t[]>(byte_size)) {}
 
 MemoryUnit::MemoryUnit(std::ifstream& file_in) {
     file_in.seekg(0, std::ios::end);
@@ -19,6 +18,10 @@ MemoryUnit::MemoryUnit(std::ifstream& file_in) {
     }
 }
 
+MemoryUnit::MemoryUnit(const MemoryUnit& other): byte_size_(other.byte_size_), memory_block_(std::make_unique<uint8_t[]>(other.byte_size_)) {
+    std::copy_n(other.memory_block_.get(), byte_size_, memory_block_.get());
+}
+
 uint8_t MemoryUnit::read(const uint16_t& address) const {
     return memory_block_[address];
 }
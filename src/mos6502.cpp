@@ -1,6 +1,10 @@
 #include "mos6502.hpp"
 // Stardard Library Headers
 #include <bitset>
+#include <algorithm>
+#ifdef MOS6502_OPCODE_COUNTERS
+#include <iomanip>
+#endif
 // Project Headers
 #include "bus.hpp"
 
@@ -63,26 +67,6 @@ MOS6502::Pointer& MOS6502::Pointer::operator+=(const int16_t& increment) {
 
 // ----------------------------- MOS6502 Class ---------------------------------
 
-// Thanks to One Lone Coder for the opcode table
-const std::array<MOS6502::Instruction, MOS6502_NUMBER_OF_INSTRUCTIONS> MOS6502::instruction_lookup_table = {{
-    { "BRK", MOS6502::BRK, MOS6502::IMM, 7 },{ "ORA", MOS6502::ORA, MOS6502::IZX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 3 },{ "ORA", MOS6502::ORA, MOS6502::ZP0, 3 },{ "ASL", MOS6502::ASL, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "PHP", MOS6502::PHP, MOS6502::IMP, 3 },{ "ORA", MOS6502::ORA, MOS6502::IMM, 2 },{ "ASL", MOS6502::ASL, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "ORA", MOS6502::ORA, MOS6502::ABS, 4 },{ "ASL", MOS6502::ASL, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BPL", MOS6502::BPL, MOS6502::REL, 2 },{ "ORA", MOS6502::ORA, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "ORA", MOS6502::ORA, MOS6502::ZPX, 4 },{ "ASL", MOS6502::ASL, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "CLC", MOS6502::CLC, MOS6502::IMP, 2 },{ "ORA", MOS6502::ORA, MOS6502::ABY, 4 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "ORA", MOS6502::ORA, MOS6502::ABX, 4 },{ "ASL", MOS6502::ASL, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-    { "JSR", MOS6502::JSR, MOS6502::ABS, 6 },{ "AND", MOS6502::AND, MOS6502::IZX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "BIT", MOS6502::BIT, MOS6502::ZP0, 3 },{ "AND", MOS6502::AND, MOS6502::ZP0, 3 },{ "ROL", MOS6502::ROL, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "PLP", MOS6502::PLP, MOS6502::IMP, 4 },{ "AND", MOS6502::AND, MOS6502::IMM, 2 },{ "ROL", MOS6502::ROL, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "BIT", MOS6502::BIT, MOS6502::ABS, 4 },{ "AND", MOS6502::AND, MOS6502::ABS, 4 },{ "ROL", MOS6502::ROL, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BMI", MOS6502::BMI, MOS6502::REL, 2 },{ "AND", MOS6502::AND, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "AND", MOS6502::AND, MOS6502::ZPX, 4 },{ "ROL", MOS6502::ROL, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "SEC", MOS6502::SEC, MOS6502::IMP, 2 },{ "AND", MOS6502::AND, MOS6502::ABY, 4 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "AND", MOS6502::AND, MOS6502::ABX, 4 },{ "ROL", MOS6502::ROL, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-    { "RTI", MOS6502::RTI, MOS6502::IMP, 6 },{ "EOR", MOS6502::EOR, MOS6502::IZX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 3 },{ "EOR", MOS6502::EOR, MOS6502::ZP0, 3 },{ "LSR", MOS6502::LSR, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "PHA", MOS6502::PHA, MOS6502::IMP, 3 },{ "EOR", MOS6502::EOR, MOS6502::IMM, 2 },{ "LSR", MOS6502::LSR, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "JMP", MOS6502::JMP, MOS6502::ABS, 3 },{ "EOR", MOS6502::EOR, MOS6502::ABS, 4 },{ "LSR", MOS6502::LSR, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BVC", MOS6502::BVC, MOS6502::REL, 2 },{ "EOR", MOS6502::EOR, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "EOR", MOS6502::EOR, MOS6502::ZPX, 4 },{ "LSR", MOS6502::LSR, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "CLI", MOS6502::CLI, MOS6502::IMP, 2 },{ "EOR", MOS6502::EOR, MOS6502::ABY, 4 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "EOR", MOS6502::EOR, MOS6502::ABX, 4 },{ "LSR", MOS6502::LSR, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-    { "RTS", MOS6502::RTS, MOS6502::IMP, 6 },{ "ADC", MOS6502::ADC, MOS6502::IZX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 3 },{ "ADC", MOS6502::ADC, MOS6502::ZP0, 3 },{ "ROR", MOS6502::ROR, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "PLA", MOS6502::PLA, MOS6502::IMP, 4 },{ "ADC", MOS6502::ADC, MOS6502::IMM, 2 },{ "ROR", MOS6502::ROR, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "JMP", MOS6502::JMP, MOS6502::IND, 5 },{ "ADC", MOS6502::ADC, MOS6502::ABS, 4 },{ "ROR", MOS6502::ROR, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BVS", MOS6502::BVS, MOS6502::REL, 2 },{ "ADC", MOS6502::ADC, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "ADC", MOS6502::ADC, MOS6502::ZPX, 4 },{ "ROR", MOS6502::ROR, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "SEI", MOS6502::SEI, MOS6502::IMP, 2 },{ "ADC", MOS6502::ADC, MOS6502::ABY, 4 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "ADC", MOS6502::ADC, MOS6502::ABX, 4 },{ "ROR", MOS6502::ROR, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-    { "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "STA", MOS6502::STA, MOS6502::IZX, 6 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "STY", MOS6502::STY, MOS6502::ZP0, 3 },{ "STA", MOS6502::STA, MOS6502::ZP0, 3 },{ "STX", MOS6502::STX, MOS6502::ZP0, 3 },{ "???", MOS6502::XXX, MOS6502::IMP, 3 },{ "DEY", MOS6502::DEY, MOS6502::IMP, 2 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "TXA", MOS6502::TXA, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "STY", MOS6502::STY, MOS6502::ABS, 4 },{ "STA", MOS6502::STA, MOS6502::ABS, 4 },{ "STX", MOS6502::STX, MOS6502::ABS, 4 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },
-    { "BCC", MOS6502::BCC, MOS6502::REL, 2 },{ "STA", MOS6502::STA, MOS6502::IZY, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "STY", MOS6502::STY, MOS6502::ZPX, 4 },{ "STA", MOS6502::STA, MOS6502::ZPX, 4 },{ "STX", MOS6502::STX, MOS6502::ZPY, 4 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },{ "TYA", MOS6502::TYA, MOS6502::IMP, 2 },{ "STA", MOS6502::STA, MOS6502::ABY, 5 },{ "TXS", MOS6502::TXS, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "???", MOS6502::NOP, MOS6502::IMP, 5 },{ "STA", MOS6502::STA, MOS6502::ABX, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },
-    { "LDY", MOS6502::LDY, MOS6502::IMM, 2 },{ "LDA", MOS6502::LDA, MOS6502::IZX, 6 },{ "LDX", MOS6502::LDX, MOS6502::IMM, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "LDY", MOS6502::LDY, MOS6502::ZP0, 3 },{ "LDA", MOS6502::LDA, MOS6502::ZP0, 3 },{ "LDX", MOS6502::LDX, MOS6502::ZP0, 3 },{ "???", MOS6502::XXX, MOS6502::IMP, 3 },{ "TAY", MOS6502::TAY, MOS6502::IMP, 2 },{ "LDA", MOS6502::LDA, MOS6502::IMM, 2 },{ "TAX", MOS6502::TAX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "LDY", MOS6502::LDY, MOS6502::ABS, 4 },{ "LDA", MOS6502::LDA, MOS6502::ABS, 4 },{ "LDX", MOS6502::LDX, MOS6502::ABS, 4 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },
-    { "BCS", MOS6502::BCS, MOS6502::REL, 2 },{ "LDA", MOS6502::LDA, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "LDY", MOS6502::LDY, MOS6502::ZPX, 4 },{ "LDA", MOS6502::LDA, MOS6502::ZPX, 4 },{ "LDX", MOS6502::LDX, MOS6502::ZPY, 4 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },{ "CLV", MOS6502::CLV, MOS6502::IMP, 2 },{ "LDA", MOS6502::LDA, MOS6502::ABY, 4 },{ "TSX", MOS6502::TSX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },{ "LDY", MOS6502::LDY, MOS6502::ABX, 4 },{ "LDA", MOS6502::LDA, MOS6502::ABX, 4 },{ "LDX", MOS6502::LDX, MOS6502::ABY, 4 },{ "???", MOS6502::XXX, MOS6502::IMP, 4 },
-    { "CPY", MOS6502::CPY, MOS6502::IMM, 2 },{ "CMP", MOS6502::CMP, MOS6502::IZX, 6 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "CPY", MOS6502::CPY, MOS6502::ZP0, 3 },{ "CMP", MOS6502::CMP, MOS6502::ZP0, 3 },{ "DEC", MOS6502::DEC, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "INY", MOS6502::INY, MOS6502::IMP, 2 },{ "CMP", MOS6502::CMP, MOS6502::IMM, 2 },{ "DEX", MOS6502::DEX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "CPY", MOS6502::CPY, MOS6502::ABS, 4 },{ "CMP", MOS6502::CMP, MOS6502::ABS, 4 },{ "DEC", MOS6502::DEC, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BNE", MOS6502::BNE, MOS6502::REL, 2 },{ "CMP", MOS6502::CMP, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "CMP", MOS6502::CMP, MOS6502::ZPX, 4 },{ "DEC", MOS6502::DEC, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "CLD", MOS6502::CLD, MOS6502::IMP, 2 },{ "CMP", MOS6502::CMP, MOS6502::ABY, 4 },{ "NOP", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "CMP", MOS6502::CMP, MOS6502::ABX, 4 },{ "DEC", MOS6502::DEC, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-    { "CPX", MOS6502::CPX, MOS6502::IMM, 2 },{ "SBC", MOS6502::SBC, MOS6502::IZX, 6 },{ "???", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "CPX", MOS6502::CPX, MOS6502::ZP0, 3 },{ "SBC", MOS6502::SBC, MOS6502::ZP0, 3 },{ "INC", MOS6502::INC, MOS6502::ZP0, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 5 },{ "INX", MOS6502::INX, MOS6502::IMP, 2 },{ "SBC", MOS6502::SBC, MOS6502::IMM, 2 },{ "NOP", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::SBC, MOS6502::IMP, 2 },{ "CPX", MOS6502::CPX, MOS6502::ABS, 4 },{ "SBC", MOS6502::SBC, MOS6502::ABS, 4 },{ "INC", MOS6502::INC, MOS6502::ABS, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },
-    { "BEQ", MOS6502::BEQ, MOS6502::REL, 2 },{ "SBC", MOS6502::SBC, MOS6502::IZY, 5 },{ "???", MOS6502::XXX, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 8 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "SBC", MOS6502::SBC, MOS6502::ZPX, 4 },{ "INC", MOS6502::INC, MOS6502::ZPX, 6 },{ "???", MOS6502::XXX, MOS6502::IMP, 6 },{ "SED", MOS6502::SED, MOS6502::IMP, 2 },{ "SBC", MOS6502::SBC, MOS6502::ABY, 4 },{ "NOP", MOS6502::NOP, MOS6502::IMP, 2 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },{ "???", MOS6502::NOP, MOS6502::IMP, 4 },{ "SBC", MOS6502::SBC, MOS6502::ABX, 4 },{ "INC", MOS6502::INC, MOS6502::ABX, 7 },{ "???", MOS6502::XXX, MOS6502::IMP, 7 },
-}};
-
 MOS6502::MOS6502(): bus(nullptr), program_counter_(MOS6502_STARTING_PC_ADDRESS), stack_ptr_(0), accumulator_(0), 
                     x_reg_(0), y_reg_(0), processor_status_({.RAW_VALUE=0b00110110}),
                     cycles_elapsed_(0), instruction_(nullptr), instruction_opcode_(0x00), 
@@ -95,7 +79,12 @@ void MOS6502::connectBUS(BUS* target_bus) {
     reset();
 }
 
+BUS* MOS6502::getConnectedBUS() const {
+    return bus;
+}
+
 void MOS6502::runInstruction() {
+    const uint16_t instruction_address = program_counter_;
     instruction_opcode_ = readMemory(program_counter_);
     program_counter_++;
 
@@ -111,8 +100,15 @@ void MOS6502::runInstruction() {
     if (instruction_cycle_mode == CycleType::ACCEPTS_ADDITIONAL_CYCLES) {
         instruction_cycle_remaining_ += additional_cycles;
     }
+#ifdef MOS6502_OPCODE_COUNTERS
+    countOpcode(instruction_cycle_mode == CycleType::ACCEPTS_ADDITIONAL_CYCLES ? additional_cycles : 0);
+#endif
     
     cycles_elapsed_ += instruction_cycle_remaining_;
+
+    if (!observers_.empty()) [[unlikely]] {
+        notifyObservers(instruction_address);
+    }
 }
 
 void MOS6502::runCycle() {
@@ -120,6 +116,7 @@ void MOS6502::runCycle() {
 
     // Fetch a new instruction when the current instruction is done
     if (instruction_cycle_remaining_ == 0) {
+        const uint16_t instruction_address = program_counter_;
         instruction_opcode_ = readMemory(program_counter_);
         program_counter_++;
 
@@ -135,6 +132,13 @@ void MOS6502::runCycle() {
         if (instruction_cycle_mode == CycleType::ACCEPTS_ADDITIONAL_CYCLES) {
             instruction_cycle_remaining_ += additional_cycles;
         }
+#ifdef MOS6502_OPCODE_COUNTERS
+        countOpcode(instruction_cycle_mode == CycleType::ACCEPTS_ADDITIONAL_CYCLES ? additional_cycles : 0);
+#endif
+
+        if (!observers_.empty()) [[unlikely]] {
+            notifyObservers(instruction_address);
+        }
     }
 
     instruction_cycle_remaining_--;
@@ -184,9 +188,14 @@ void MOS6502::irq() {
 
     setStatusFlag(StatusFlag::INTERRUPT_DISABLE, 1);
 
+    const uint16_t return_address = program_counter_;
     uint16_t irq_pc_low_byte = readMemory(MOS6502_IRQ_PC_ADDRESS);
     uint16_t irq_pc_high_byte = readMemory(MOS6502_IRQ_PC_ADDRESS + 1);
     program_counter_ = (irq_pc_high_byte << 8) | irq_pc_low_byte;
+
+    for (CPUObserver* observer : observers_) {
+        observer->onInterrupt(*this, CPUObserver::Interrupt::IRQ, return_address);
+    }
 }
 
 void MOS6502::nmi() {
@@ -203,9 +212,14 @@ void MOS6502::nmi() {
 
     setStatusFlag(StatusFlag::INTERRUPT_DISABLE, 1);
 
+    const uint16_t return_address = program_counter_;
     uint16_t nmi_pc_low_byte = readMemory(MOS6502_NMI_PC_ADDRESS);
     uint16_t nmi_pc_high_byte = readMemory(MOS6502_NMI_PC_ADDRESS + 1);
     program_counter_ = (nmi_pc_high_byte << 8) | nmi_pc_low_byte;
+
+    for (CPUObserver* observer : observers_) {
+        observer->onInterrupt(*this, CPUObserver::Interrupt::NMI, return_address);
+    }
 }
 
 // ------------------------ INTERNAL FUNCTIONS ---------------------------------
@@ -214,6 +228,10 @@ uint64_t MOS6502::getCyclesElapsed() const {
     return cycles_elapsed_;
 }
 
+uint8_t MOS6502::getInstructionCyclesRemaining() const {
+    return instruction_cycle_remaining_;
+}
+
 MOS6502::State MOS6502::getState() const {
     return State{program_counter_, stack_ptr_, accumulator_, x_reg_, y_reg_, processor_status_.RAW_VALUE};
 }
@@ -239,6 +257,80 @@ void MOS6502::outputCurrentState(std::ostream &out) const {
     out << "Cycles Elapsed : " << cycles_elapsed_ << std::endl;
 }
 
+void MOS6502::addObserver(CPUObserver* observer) {
+    observers_.push_back(observer);
+}
+
+void MOS6502::removeObserver(CPUObserver* observer) {
+    observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+}
+
+void MOS6502::notifyObservers(const uint16_t& instruction_address) const {
+    for (CPUObserver* observer : observers_) {
+        observer->onInstruction(*this, instruction_address, instruction_opcode_, instruction_cycle_remaining_);
+    }
+}
+
+#ifdef MOS6502_OPCODE_COUNTERS
+const std::array<MOS6502::OpcodeCounter, MOS6502_NUMBER_OF_INSTRUCTIONS>& MOS6502::getOpcodeCounters() const {
+    return opcode_counters_;
+}
+
+void MOS6502::resetOpcodeCounters() {
+    opcode_counters_.fill(OpcodeCounter{});
+}
+
+void MOS6502::writeOpcodeCounterTable(std::ostream& out) const {
+    std::vector<uint8_t> executed_opcodes;
+    uint64_t total_executions = 0;
+    for (uint16_t opcode = 0; opcode < MOS6502_NUMBER_OF_INSTRUCTIONS; opcode++) {
+        if (opcode_counters_[opcode].executions == 0) continue;
+        executed_opcodes.push_back(opcode);
+        total_executions += opcode_counters_[opcode].executions;
+    }
+    std::stable_sort(executed_opcodes.begin(), executed_opcodes.end(), [this](const uint8_t& a, const uint8_t& b) {
+        return opcode_counters_[a].executions > opcode_counters_[b].executions;
+    });
+
+    out << "Opcode  Instruction" << std::setw(14) << "Executions" << std::setw(9) << "Mix" << std::setw(14) << "Cycles" << std::setw(14) << "Page crosses" << "\n";
+    for (const uint8_t& opcode : executed_opcodes) {
+        const OpcodeCounter& counter = opcode_counters_[opcode];
+        out << "  " << std::hex << std::setfill('0') << std::setw(2) << static_cast<uint16_t>(opcode) << std::dec << std::setfill(' ');
+        out << "    " << instruction_lookup_table[opcode].name << " " << getAddressingModeName(opcode) << "    ";
+        out << std::setw(14) << counter.executions << std::fixed << std::setprecision(2);
+        out << std::setw(8) << 100.0 * counter.executions / total_executions << "%" << std::defaultfloat;
+        out << std::setw(14) << counter.cycles << std::setw(14) << counter.page_cross_penalties << "\n";
+    }
+}
+
+void MOS6502::writeOpcodeCounterJSON(std::ostream& out) const {
+    out << "[";
+    bool first = true;
+    for (uint16_t opcode = 0; opcode < MOS6502_NUMBER_OF_INSTRUCTIONS; opcode++) {
+        const OpcodeCounter& counter = opcode_counters_[opcode];
+        if (counter.executions == 0) continue;
+        out << (first ? "\n" : ",\n") << "  {\"opcode\": " << opcode << ", \"name\": \"" << instruction_lookup_table[opcode].name;
+        out << "\", \"addressing_mode\": \"" << getAddressingModeName(opcode) << "\", \"executions\": " << counter.executions;
+        out << ", \"cycles\": " << counter.cycles << ", \"page_cross_penalties\": " << counter.page_cross_penalties << "}";
+        first = false;
+    }
+    out << (first ? "]" : "\n]") << std::endl;
+}
+
+void MOS6502::countOpcode(const uint8_t& additional_cycles) {
+    OpcodeCounter& counter = opcode_counters_[instruction_opcode_];
+    counter.executions++;
+    counter.cycles += instruction_cycle_remaining_;
+    if (instruction_->addressing_mode == AddressingMode::REL) {
+        // Branches add their own cycles: 1 when taken and 1 more when the target is on another page
+        counter.page_cross_penalties += instruction_cycle_remaining_ - instruction_->cycles == 2;
+    }
+    else {
+        counter.page_cross_penalties += additional_cycles;
+    }
+}
+#endif
+
 uint8_t MOS6502::readMemory(const uint16_t& address) const {
     return bus->readBusData(address);
 }
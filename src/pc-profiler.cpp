@@ -0,0 +1,69 @@
+#include "pc-profiler.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+// Project Includes
+#include "disassembler.hpp"
+
+#define PC_PROFILER_ADDRESSES 65536
+
+PCProfiler::PCProfiler(const uint64_t& sample_interval):
+    sample_interval_{sample_interval}, total_cycles_{0}, next_sample_cycle_{sample_interval},
+    instruction_counts_(PC_PROFILER_ADDRESSES), cycle_counts_(PC_PROFILER_ADDRESSES) {}
+
+void PCProfiler::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    if (sample_interval_ == 0) {
+        instruction_counts_[address]++;
+        cycle_counts_[address] += cycles;
+        return;
+    }
+
+    total_cycles_ += cycles;
+    // An instruction longer than the interval takes every sample that fell inside it
+    while (total_cycles_ >= next_sample_cycle_) [[unlikely]] {
+        instruction_counts_[address]++;
+        cycle_counts_[address] += sample_interval_;
+        next_sample_cycle_ += sample_interval_;
+    }
+}
+
+uint64_t PCProfiler::getInstructions(const uint16_t& address) const {
+    return instruction_counts_[address];
+}
+
+uint64_t PCProfiler::getCycles(const uint16_t& address) const {
+    return cycle_counts_[address];
+}
+
+void PCProfiler::reset() {
+    std::fill(instruction_counts_.begin(), instruction_counts_.end(), 0);
+    std::fill(cycle_counts_.begin(), cycle_counts_.end(), 0);
+    total_cycles_ = 0;
+    next_sample_cycle_ = sample_interval_;
+}
+
+void PCProfiler::writeReport(std::ostream& out, const MemoryUnit& memory, const size_t& top) const {
+    std::vector<uint16_t> addresses;
+    for (uint32_t address = 0; address < PC_PROFILER_ADDRESSES; address++) {
+        if (instruction_counts_[address] != 0) addresses.push_back(address);
+    }
+    std::sort(addresses.begin(), addresses.end(), [this](const uint16_t& a, const uint16_t& b) {
+        return cycle_counts_[a] != cycle_counts_[b] ? cycle_counts_[a] > cycle_counts_[b] : a < b;
+    });
+    const uint64_t total_cycles = std::accumulate(cycle_counts_.begin(), cycle_counts_.end(), uint64_t{0});
+
+    out << std::left << std::setw(9) << "Address" << std::right << std::setw(14) << (sample_interval_ == 0 ? "Instructions" : "Samples");
+    out << std::setw(14) << "Cycles" << std::setw(9) << "Self" << std::setw(9) << "Total" << "  Instruction\n";
+    double cumulative_percent = 0;
+    for (size_t i = 0; i < std::min(top, addresses.size()); i++) {
+        const uint16_t address = addresses[i];
+        const double percent = 100.0 * cycle_counts_[address] / total_cycles;
+        cumulative_percent += percent;
+        out << "$" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << address << std::dec << std::nouppercase << std::setfill(' ');
+        out << "    " << std::setw(14) << instruction_counts_[address] << std::setw(14) << cycle_counts_[address] << std::fixed << std::setprecision(2);
+        out << std::setw(8) << percent << "%" << std::setw(8) << cumulative_percent << "%" << std::defaultfloat;
+        out << "  " << disassembleInstruction(memory, address) << "\n";
+    }
+    out << addresses.size() << " addresses executed, " << total_cycles << " cycles" << (sample_interval_ == 0 ? "" : " (estimated from samples)") << "\n";
+}
@@ -0,0 +1,103 @@
+#include "perf-counters.hpp"
+// Standard Library Includes
+#include <cstring>
+#include <cerrno>
+// POSIX Includes
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static perf_event_attr counter_attributes(const PerfCounters::Counter& counter) {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.disabled = 1;
+    // Kernel and hypervisor events need more privileges, the emulator only runs in user space anyway
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    const uint64_t cache_read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch (counter) {
+        case PerfCounters::Counter::CYCLES:
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounters::Counter::INSTRUCTIONS:
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounters::Counter::BRANCH_MISSES:
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfCounters::Counter::L1I_MISSES:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1I | cache_read_miss;
+            break;
+        case PerfCounters::Counter::L1D_MISSES:
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D | cache_read_miss;
+            break;
+    }
+    return attributes;
+}
+
+PerfCounters::PerfCounters() {
+    file_descriptors_.fill(-1);
+    for (size_t i = 0; i < COUNTER_COUNT; i++) {
+        perf_event_attr attributes = counter_attributes(static_cast<Counter>(i));
+        // glibc has no wrapper for perf_event_open
+        file_descriptors_[i] = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+        if (file_descriptors_[i] < 0 && unavailable_reason_.empty()) {
+            unavailable_reason_ = std::string(counter_names[i]) + ": " + std::strerror(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (const int& file_descriptor : file_descriptors_) {
+        if (file_descriptor >= 0) close(file_descriptor);
+    }
+}
+
+bool PerfCounters::available() const {
+    for (const int& file_descriptor : file_descriptors_) {
+        if (file_descriptor >= 0) return true;
+    }
+    return false;
+}
+
+const std::string& PerfCounters::unavailableReason() const {
+    return unavailable_reason_;
+}
+
+void PerfCounters::start() {
+    for (const int& file_descriptor : file_descriptors_) {
+        if (file_descriptor < 0) continue;
+        ioctl(file_descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(file_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void PerfCounters::stop() {
+    for (const int& file_descriptor : file_descriptors_) {
+        if (file_descriptor >= 0) ioctl(file_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+std::optional<uint64_t> PerfCounters::read(const Counter& counter) const {
+    const int file_descriptor = file_descriptors_[static_cast<size_t>(counter)];
+    if (file_descriptor < 0) return std::nullopt;
+
+    // value, time enabled, time running
+    uint64_t values[3] = {};
+    if (::read(file_descriptor, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+        return std::nullopt;
+    }
+    if (values[2] < values[1]) {
+        return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+    }
+    return values[0];
+}
@@ -0,0 +1,154 @@
+#include "result-cache.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <vector>
+#include <cstring>
+// Generated Includes
+#include "handler-fingerprints.hpp"
+
+#define FNV_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+static uint64_t hash_bytes(const void* data, const size_t& size, uint64_t hash = FNV_OFFSET_BASIS) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t index = 0;
+    // FNV-1a over 8 byte words keeps hashing the multi-megabyte test files cheap
+    for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + index, sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (; index < size; index++) {
+        hash = (hash ^ bytes[index]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t hash_string(const std::string_view& text, const uint64_t& hash) {
+    return hash_bytes(text.data(), text.size(), hash);
+}
+
+static std::string hash_to_string(const uint64_t& hash) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+static uint32_t handler_fingerprint(const std::string_view& handler_name) {
+    for (const HandlerFingerprint& handler : handler_fingerprints) {
+        if (handler.name == handler_name) return handler.fingerprint;
+    }
+    return 0;
+}
+
+static std::string opcode_string(const uint8_t& opcode) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(2) << std::setfill('0') << unsigned(opcode);
+    return ss.str();
+}
+
+ResultCache::ResultCache(const std::string& file_path): file_path_{file_path}, entries_(json::object()) {
+    std::ifstream cache_file(file_path_);
+    if (!cache_file) return;
+    try {
+        entries_ = json::parse(cache_file);
+    }
+    catch (const json::exception&) {
+        // A corrupt cache only costs a full run
+        entries_ = json::object();
+    }
+}
+
+ResultCache::FileHash ResultCache::hashTestFile(const uint8_t& opcode, const std::string& test_file_path) const {
+    std::error_code error;
+    FileHash test_file{0, 0, ""};
+    test_file.file_size = std::filesystem::file_size(test_file_path, error);
+    if (error) return test_file;
+    test_file.file_mtime = std::filesystem::last_write_time(test_file_path, error).time_since_epoch().count();
+
+    const std::string opcode_name = opcode_string(opcode);
+    if (entries_.contains(opcode_name)) {
+        const json& cached = entries_[opcode_name];
+        if (cached.value("file_size", uint64_t{0}) == test_file.file_size && cached.value("file_mtime", int64_t{0}) == test_file.file_mtime) {
+            test_file.hash = cached.value("file_hash", "");
+            return test_file;
+        }
+    }
+
+    std::ifstream file_in(test_file_path, std::ios::binary);
+    std::vector<char> chunk(1 << 20);
+    uint64_t hash = FNV_OFFSET_BASIS;
+    while (file_in.read(chunk.data(), chunk.size()) || file_in.gcount() > 0) {
+        hash = hash_bytes(chunk.data(), file_in.gcount(), hash);
+    }
+    test_file.hash = hash_to_string(hash);
+    return test_file;
+}
+
+std::string ResultCache::opcodeKey(const uint8_t& opcode, const FileHash& test_file, const HarnessOptions& options) {
+    const MOS6502::Instruction& instruction = MOS6502::instruction_lookup_table.at(opcode);
+
+    // Build identity
+    uint64_t hash = hash_string(MOS6502_BUILD_FLAGS, FNV_OFFSET_BASIS);
+    hash = hash_string(__VERSION__, hash);
+    const uint32_t core_fingerprint = MOS6502_CORE_FINGERPRINT;
+    hash = hash_bytes(&core_fingerprint, sizeof(core_fingerprint), hash);
+    // Only options that can change a pass into a fail belong in the key
+    hash = hash_string(options.verify_bus ? "verify_bus" : "", hash);
+
+    // Per-opcode fingerprint
+    const uint32_t opcode_fingerprints[] = {
+        opcode,
+        instruction.cycles,
+        // By the handler that runs, the mnemonic of every unofficial opcode is "???"
+        handler_fingerprint(MOS6502::getOperationName(opcode)),
+        handler_fingerprint(MOS6502::getAddressingModeName(opcode)),
+    };
+    hash = hash_bytes(opcode_fingerprints, sizeof(opcode_fingerprints), hash);
+
+    hash = hash_string(test_file.hash, hash);
+    return hash_to_string(hash);
+}
+
+std::optional<ResultCache::Entry> ResultCache::lookup(const uint8_t& opcode, const std::string& key) const {
+    const std::string opcode_name = opcode_string(opcode);
+    if (!entries_.contains(opcode_name) || entries_[opcode_name].value("key", "") != key) {
+        return std::nullopt;
+    }
+    const json& cached = entries_[opcode_name];
+    Entry entry{key, {cached["file_size"], cached["file_mtime"], cached["file_hash"]}, cached["passed"], {cached["tests_run"], cached["tests_passed"], std::nullopt, "", "", {}}};
+    if (!cached["first_failure_index"].is_null()) {
+        entry.summary.first_failure_index = cached["first_failure_index"].get<uint32_t>();
+        entry.summary.first_failure_name = cached["first_failure_name"];
+        entry.summary.first_failure_diff = cached["first_failure_diff"];
+    }
+    return entry;
+}
+
+void ResultCache::store(const uint8_t& opcode, const Entry& entry) {
+    json cached = {
+        {"key", entry.key},
+        {"file_size", entry.test_file.file_size},
+        {"file_mtime", entry.test_file.file_mtime},
+        {"file_hash", entry.test_file.hash},
+        {"passed", entry.passed},
+        {"tests_run", entry.summary.tests_run},
+        {"tests_passed", entry.summary.tests_passed},
+        {"first_failure_index", nullptr},
+        {"first_failure_name", entry.summary.first_failure_name},
+        {"first_failure_diff", entry.summary.first_failure_diff},
+    };
+    if (entry.summary.first_failure_index.has_value()) {
+        cached["first_failure_index"] = *entry.summary.first_failure_index;
+    }
+    entries_[opcode_string(opcode)] = cached;
+}
+
+bool ResultCache::save() const {
+    std::ofstream cache_file(file_path_, std::ios::trunc);
+    cache_file << entries_.dump(1) << "\n";
+    return static_cast<bool>(cache_file);
+}
@@ -0,0 +1,73 @@
+#include "shadow-call-stack.hpp"
+// Project Includes
+#include "mos6502.hpp"
+
+#define OPCODE_BRK 0x00
+#define OPCODE_JSR 0x20
+#define OPCODE_JMP_ABS 0x4C
+#define OPCODE_JMP_IND 0x6C
+
+ShadowCallStack::ShadowCallStack(Listener& listener):
+    listener_{listener}, frames_{}, function_entries_(65536) {}
+
+void ShadowCallStack::onInstruction(const MOS6502& cpu, const uint8_t& opcode) {
+    const MOS6502::State state = cpu.getState();
+    switch (opcode) {
+        case OPCODE_JSR:
+            // JSR pushed a 2 byte return address
+            push(Frame{state.program_counter, static_cast<uint8_t>(state.stack_ptr + 2), FrameType::SUBROUTINE});
+            break;
+        case OPCODE_BRK:
+            // BRK pushed a 2 byte return address and the status
+            push(Frame{state.program_counter, static_cast<uint8_t>(state.stack_ptr + 3), FrameType::BRK});
+            break;
+        case OPCODE_JMP_ABS:
+        case OPCODE_JMP_IND:
+            // Only a jump into another function is a tail call, a jump to the current entry is a loop
+            if (function_entries_[state.program_counter] && !frames_.empty() && frames_.back().function != state.program_counter) {
+                const Frame previous = frames_.back();
+                frames_.back() = Frame{state.program_counter, previous.return_stack_ptr, FrameType::SUBROUTINE};
+                listener_.onTailCall(previous, frames_.back());
+            }
+            break;
+        default:
+            // Any instruction that raises the stack pointer may have dropped return addresses
+            while (!frames_.empty() && frames_.back().return_stack_ptr <= state.stack_ptr) {
+                pop();
+            }
+            break;
+    }
+}
+
+void ShadowCallStack::onInterrupt(const MOS6502& cpu, const CPUObserver::Interrupt& interrupt) {
+    const MOS6502::State state = cpu.getState();
+    // The interrupt pushed a 2 byte return address and the status
+    const FrameType type = interrupt == CPUObserver::Interrupt::NMI ? FrameType::NMI : FrameType::IRQ;
+    push(Frame{state.program_counter, static_cast<uint8_t>(state.stack_ptr + 3), type});
+}
+
+void ShadowCallStack::addFunctionEntry(const uint16_t& address) {
+    function_entries_[address] = true;
+}
+
+void ShadowCallStack::unwind() {
+    while (!frames_.empty()) {
+        pop();
+    }
+}
+
+const std::vector<ShadowCallStack::Frame>& ShadowCallStack::getFrames() const {
+    return frames_;
+}
+
+void ShadowCallStack::push(const Frame& frame) {
+    function_entries_[frame.function] = true;
+    frames_.push_back(frame);
+    listener_.onCall(frame);
+}
+
+void ShadowCallStack::pop() {
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+    listener_.onReturn(frame);
+}
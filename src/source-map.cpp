@@ -0,0 +1,73 @@
+#include "source-map.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <tuple>
+#include <stdexcept>
+
+// Splits a debug file record ("line	id=4,file=0,line=12,span=3+7") into its key=value fields
+static std::map<std::string, std::string> dbg_fields(const std::string& record) {
+    std::map<std::string, std::string> fields;
+    std::stringstream field_list(record.substr(record.find_first_of(" \t") + 1));
+    for (std::string field; std::getline(field_list, field, ',');) {
+        const size_t separator = field.find('=');
+        if (separator == std::string::npos) continue;
+        std::string value = field.substr(separator + 1);
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+        fields[field.substr(0, separator)] = value;
+    }
+    return fields;
+}
+
+size_t SourceMap::loadFile(const std::string& file_path) {
+    std::ifstream file_in(file_path);
+    if (!file_in) {
+        throw std::runtime_error("Unable to open debug file " + file_path);
+    }
+
+    std::map<std::string, std::string> file_names;
+    std::map<std::string, uint32_t> segment_starts;
+    // Span id to segment id, offset in the segment and size
+    std::map<std::string, std::tuple<std::string, uint32_t, uint32_t>> spans;
+    std::vector<std::map<std::string, std::string>> line_records;
+    for (std::string record; std::getline(file_in, record);) {
+        const std::string record_type = record.substr(0, record.find_first_of(" \t"));
+        if (record_type == "file") {
+            std::map<std::string, std::string> fields = dbg_fields(record);
+            file_names[fields["id"]] = fields["name"];
+        }
+        else if (record_type == "seg") {
+            std::map<std::string, std::string> fields = dbg_fields(record);
+            segment_starts[fields["id"]] = std::stoul(fields["start"], nullptr, 0);
+        }
+        else if (record_type == "span") {
+            std::map<std::string, std::string> fields = dbg_fields(record);
+            spans[fields["id"]] = {fields["seg"], std::stoul(fields["start"], nullptr, 0), std::stoul(fields["size"], nullptr, 0)};
+        }
+        else if (record_type == "line") {
+            line_records.push_back(dbg_fields(record));
+        }
+    }
+
+    // Lines come before the spans they reference, so they are resolved once everything is read
+    for (std::map<std::string, std::string>& fields : line_records) {
+        if (fields["span"].empty()) continue;
+        SourceLine source_line{file_names[fields["file"]], static_cast<uint32_t>(std::stoul(fields["line"])), {}};
+        std::stringstream span_ids(fields["span"]);
+        for (std::string span_id; std::getline(span_ids, span_id, '+');) {
+            const auto span = spans.find(span_id);
+            if (span == spans.end()) continue;
+            const auto& [segment, offset, size] = span->second;
+            source_line.ranges.push_back(AddressRange{static_cast<uint16_t>(segment_starts[segment] + offset), size});
+        }
+        if (!source_line.ranges.empty()) lines_.push_back(source_line);
+    }
+    return lines_.size();
+}
+
+const std::vector<SourceMap::SourceLine>& SourceMap::getLines() const {
+    return lines_;
+}
@@ -0,0 +1,146 @@
+#include "stack-analyzer.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <iomanip>
+// Project Includes
+#include "mos6502.hpp"
+
+#define STACK_ANALYZER_MAX_WRAPAROUNDS 64
+
+#define OPCODE_BRK 0x00
+#define OPCODE_PHP 0x08
+#define OPCODE_JSR 0x20
+#define OPCODE_PLP 0x28
+#define OPCODE_RTI 0x40
+#define OPCODE_PHA 0x48
+#define OPCODE_RTS 0x60
+#define OPCODE_PLA 0x68
+#define OPCODE_TXS 0x9A
+
+static void record_usage(std::map<uint16_t, StackAnalyzer::FunctionStackUsage>& function_usage, const ShadowCallStack::Frame& frame, const uint8_t& min_stack_ptr) {
+    // Bytes of page 1 between the caller's stack pointer and the lowest one reached, a wrapped frame is skipped
+    if (min_stack_ptr < frame.return_stack_ptr) {
+        uint32_t& max_bytes = function_usage[frame.function].max_bytes;
+        max_bytes = std::max<uint32_t>(max_bytes, frame.return_stack_ptr - min_stack_ptr);
+    }
+}
+
+StackAnalyzer::StackAnalyzer(const MOS6502& cpu, const SymbolTable& symbols):
+    symbols_{symbols}, base_stack_ptr_{cpu.getState().stack_ptr}, stack_ptr_{cpu.getState().stack_ptr}, cycle_{cpu.getCyclesElapsed()},
+    min_stack_ptr_{cpu.getState().stack_ptr}, min_stack_ptr_base_{cpu.getState().stack_ptr}, min_stack_ptr_address_{cpu.getState().program_counter}, min_stack_ptr_cycle_{cycle_},
+    wraparounds_{}, overflows_{0}, underflows_{0}, shadow_call_stack_{*this}, frame_min_stack_ptrs_{}, function_usage_{} {}
+
+void StackAnalyzer::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    const MOS6502::State state = cpu.getState();
+    const bool pushed = opcode == OPCODE_PHA || opcode == OPCODE_PHP || opcode == OPCODE_JSR || opcode == OPCODE_BRK;
+    const bool pulled = opcode == OPCODE_PLA || opcode == OPCODE_PLP || opcode == OPCODE_RTS || opcode == OPCODE_RTI;
+    updateStackPtr(state.stack_ptr, pushed, pulled, opcode == OPCODE_TXS, address);
+    cycle_ += cycles;
+    shadow_call_stack_.onInstruction(cpu, opcode);
+}
+
+void StackAnalyzer::onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {
+    const MOS6502::State state = cpu.getState();
+    updateStackPtr(state.stack_ptr, true, false, false, return_address);
+    shadow_call_stack_.onInterrupt(cpu, interrupt);
+}
+
+void StackAnalyzer::updateStackPtr(const uint8_t& stack_ptr, const bool& pushed, const bool& pulled, const bool& transferred, const uint16_t& instruction_address) {
+    // A push only lowers the stack pointer and a pull only raises it, unless it wrapped around page 1
+    const bool wrapped = (pushed && stack_ptr > stack_ptr_) || (pulled && stack_ptr < stack_ptr_);
+    if (wrapped) {
+        (pushed ? overflows_ : underflows_)++;
+        if (wraparounds_.size() < STACK_ANALYZER_MAX_WRAPAROUNDS) {
+            wraparounds_.push_back(Wraparound{pushed, instruction_address, cycle_});
+        }
+    }
+    stack_ptr_ = stack_ptr;
+    // A TXS or a wraparound leaves a new stack, otherwise pulls above the base only show it started higher
+    base_stack_ptr_ = transferred || wrapped ? stack_ptr : std::max(base_stack_ptr_, stack_ptr);
+    if (base_stack_ptr_ - stack_ptr > min_stack_ptr_base_ - min_stack_ptr_) {
+        min_stack_ptr_ = stack_ptr;
+        min_stack_ptr_base_ = base_stack_ptr_;
+        min_stack_ptr_address_ = instruction_address;
+        min_stack_ptr_cycle_ = cycle_;
+    }
+    if (!frame_min_stack_ptrs_.empty()) {
+        frame_min_stack_ptrs_.back() = std::min(frame_min_stack_ptrs_.back(), stack_ptr);
+    }
+}
+
+void StackAnalyzer::onCall(const ShadowCallStack::Frame& frame) {
+    frame_min_stack_ptrs_.push_back(stack_ptr_);
+    function_usage_.try_emplace(frame.function, FunctionStackUsage{frame.function, 0, 0}).first->second.calls++;
+}
+
+void StackAnalyzer::onReturn(const ShadowCallStack::Frame& frame) {
+    const uint8_t min_stack_ptr = frame_min_stack_ptrs_.back();
+    frame_min_stack_ptrs_.pop_back();
+    record_usage(function_usage_, frame, min_stack_ptr);
+    if (!frame_min_stack_ptrs_.empty()) {
+        frame_min_stack_ptrs_.back() = std::min(frame_min_stack_ptrs_.back(), min_stack_ptr);
+    }
+}
+
+void StackAnalyzer::onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) {
+    // The previous function is done, what it used still counts for its caller
+    onReturn(previous);
+    onCall(frame);
+}
+
+uint8_t StackAnalyzer::getMinimumStackPtr() const {
+    return min_stack_ptr_;
+}
+
+const std::vector<StackAnalyzer::Wraparound>& StackAnalyzer::getWraparounds() const {
+    return wraparounds_;
+}
+
+std::vector<StackAnalyzer::FunctionStackUsage> StackAnalyzer::getFunctionStackUsage() const {
+    // Functions still running have not recorded their usage yet, each one also used what the frames above it used,
+    //   passed down the same way onReturn passes it to the caller
+    std::map<uint16_t, FunctionStackUsage> function_usage = function_usage_;
+    const std::vector<ShadowCallStack::Frame>& frames = shadow_call_stack_.getFrames();
+    uint8_t callee_min_stack_ptr = 0xFF;
+    for (size_t depth = frames.size(); depth-- > 0;) {
+        const uint8_t min_stack_ptr = std::min(frame_min_stack_ptrs_[depth], callee_min_stack_ptr);
+        record_usage(function_usage, frames[depth], min_stack_ptr);
+        callee_min_stack_ptr = min_stack_ptr;
+    }
+    std::vector<FunctionStackUsage> usage_list;
+    for (const auto& [function, usage] : function_usage) {
+        usage_list.push_back(usage);
+    }
+    std::stable_sort(usage_list.begin(), usage_list.end(), [](const FunctionStackUsage& a, const FunctionStackUsage& b) {
+        return a.max_bytes > b.max_bytes;
+    });
+    return usage_list;
+}
+
+void StackAnalyzer::writeReport(std::ostream& out, const size_t& top) const {
+    out << "Deepest stack pointer $" << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << static_cast<uint16_t>(min_stack_ptr_);
+    out << " at $" << std::setw(4) << min_stack_ptr_address_ << std::dec << std::nouppercase << std::setfill(' ');
+    out << " (cycle " << min_stack_ptr_cycle_ << "), worst-case depth ";
+    if (overflows_ > 0) {
+        out << "all 256 bytes of page 1, the stack wrapped around\n";
+    }
+    else {
+        out << min_stack_ptr_base_ - min_stack_ptr_ << " bytes below $";
+        out << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << static_cast<uint16_t>(min_stack_ptr_base_);
+        out << std::dec << std::nouppercase << std::setfill(' ') << "\n";
+    }
+
+    out << overflows_ << " overflows below $0100, " << underflows_ << " underflows above $01FF\n";
+    for (size_t i = 0; i < std::min(top, wraparounds_.size()); i++) {
+        const Wraparound& wraparound = wraparounds_[i];
+        out << "  " << (wraparound.overflow ? "overflow " : "underflow") << " at $" << std::hex << std::uppercase << std::setfill('0');
+        out << std::setw(4) << wraparound.instruction_address << std::dec << std::nouppercase << std::setfill(' ') << " (cycle " << wraparound.cycle << ")\n";
+    }
+
+    const std::vector<FunctionStackUsage> usage_list = getFunctionStackUsage();
+    out << std::left << std::setw(24) << "Function" << std::right << std::setw(10) << "Calls" << std::setw(12) << "Max bytes" << "\n";
+    for (size_t i = 0; i < std::min(top, usage_list.size()); i++) {
+        out << std::left << std::setw(24) << symbols_.name(usage_list[i].address) << std::right;
+        out << std::setw(10) << usage_list[i].calls << std::setw(12) << usage_list[i].max_bytes << "\n";
+    }
+}
@@ -0,0 +1,65 @@
+#include "symbol-table.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <stdexcept>
+
+// Gets the value of key in a ca65 debug file line of comma separated key=value pairs
+static std::string dbg_field(const std::string& line, const std::string& key) {
+    size_t position = line.find(key + "=");
+    while (position != std::string::npos && position != 0 && line[position - 1] != ',' && line[position - 1] != '\t') {
+        position = line.find(key + "=", position + 1);
+    }
+    if (position == std::string::npos) return "";
+    position += key.size() + 1;
+    if (line[position] == '"') {
+        return line.substr(position + 1, line.find('"', position + 1) - position - 1);
+    }
+    return line.substr(position, line.find(',', position) - position);
+}
+
+size_t SymbolTable::loadFile(const std::string& file_path) {
+    std::ifstream file_in(file_path);
+    if (!file_in) {
+        throw std::runtime_error("Unable to open symbol file " + file_path);
+    }
+
+    size_t labels_loaded = 0;
+    for (std::string line; std::getline(file_in, line);) {
+        // ca65: sym	id=3,name="reset",addrsize=absolute,scope=0,def=12,val=0xC000,seg=1,type=lab
+        if (line.starts_with("sym\t") || line.starts_with("sym ")) {
+            const std::string value = dbg_field(line, "val");
+            if (dbg_field(line, "type") != "lab" || value.empty()) continue;
+            add(std::stoul(value, nullptr, 0), dbg_field(line, "name"));
+            labels_loaded++;
+        }
+        // VICE: al C:c000 .reset
+        else if (line.starts_with("al ")) {
+            std::stringstream fields(line.substr(3));
+            std::string address, label;
+            fields >> address >> label;
+            if (address.starts_with("C:")) address = address.substr(2);
+            if (address.empty() || label.empty()) continue;
+            add(std::stoul(address, nullptr, 16), label.starts_with(".") ? label.substr(1) : label);
+            labels_loaded++;
+        }
+    }
+    return labels_loaded;
+}
+
+void SymbolTable::add(const uint16_t& address, const std::string& name) {
+    names_.emplace(address, name);
+}
+
+std::string SymbolTable::name(const uint16_t& address) const {
+    const auto symbol = names_.find(address);
+    if (symbol != names_.end()) return symbol->second;
+    char formatted_address[8];
+    std::snprintf(formatted_address, sizeof(formatted_address), "$%04X", address);
+    return formatted_address;
+}
+
+size_t SymbolTable::size() const {
+    return names_.size();
+}
@@ -0,0 +1,233 @@
+#include "test-corpus.hpp"
+// Standard Library Includes
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <utility>
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(TestCorpus::State) == 8);
+static_assert(sizeof(TestCorpus::RAMEntry) == 4);
+static_assert(sizeof(TestCorpus::CycleEntry) == 4);
+static_assert(sizeof(TestCorpus::TestRecord) == 40);
+static_assert(sizeof(TestCorpus::Header) == 32);
+
+static TestCorpus::State json_to_state(const json& state) {
+    return TestCorpus::State{state["pc"], state["s"], state["a"], state["x"], state["y"], state["p"], 0};
+}
+
+// Advances offset past count items of item_size bytes, returns false if the end does not fit in size_t
+static bool advance_section(size_t& offset, const size_t& count, const size_t& item_size) {
+    if (count > (SIZE_MAX - offset) / item_size) return false;
+    offset += count * item_size;
+    return true;
+}
+
+// Checks that count items starting at offset lie within a section of section_count items
+static bool range_in_section(const uint32_t& offset, const uint32_t& count, const uint32_t& section_count) {
+    return static_cast<uint64_t>(offset) + count <= section_count;
+}
+
+template <typename T>
+static void append_bytes(std::vector<uint8_t>& buffer, const T* items, const size_t& count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(items);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+}
+
+TestCorpus TestCorpus::fromJSON(const json& tests) {
+    std::vector<TestRecord> records;
+    std::vector<RAMEntry> ram_entries;
+    std::vector<CycleEntry> cycle_entries;
+    std::string names;
+    records.reserve(tests.size());
+
+    for (const auto& test : tests) {
+        const std::string& test_name = test["name"].get_ref<const std::string&>();
+        TestRecord test_record{};
+        test_record.initial = json_to_state(test["initial"]);
+        test_record.final = json_to_state(test["final"]);
+
+        test_record.name_offset = names.size();
+        test_record.name_length = test_name.size();
+        names += test_name;
+
+        test_record.initial_ram_offset = ram_entries.size();
+        test_record.initial_ram_count = test["initial"]["ram"].size();
+        for (const auto& address_value_pair : test["initial"]["ram"]) {
+            ram_entries.push_back(RAMEntry{address_value_pair[0], address_value_pair[1], 0});
+        }
+
+        test_record.final_ram_offset = ram_entries.size();
+        test_record.final_ram_count = test["final"]["ram"].size();
+        for (const auto& address_value_pair : test["final"]["ram"]) {
+            ram_entries.push_back(RAMEntry{address_value_pair[0], address_value_pair[1], 0});
+        }
+
+        test_record.cycles_offset = cycle_entries.size();
+        test_record.cycles_count = test["cycles"].size();
+        for (const auto& cycle : test["cycles"]) {
+            const BusActivity activity = cycle[2] == "write" ? BusActivity::WRITE : BusActivity::READ;
+            cycle_entries.push_back(CycleEntry{cycle[0], cycle[1], activity});
+        }
+
+        records.push_back(test_record);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, TEST_CORPUS_MAGIC, sizeof(header.magic));
+    header.version = TEST_CORPUS_VERSION;
+    header.test_count = records.size();
+    header.ram_entry_count = ram_entries.size();
+    header.cycle_entry_count = cycle_entries.size();
+    header.name_bytes = names.size();
+
+    TestCorpus corpus;
+    append_bytes(corpus.owned_buffer_, &header, 1);
+    append_bytes(corpus.owned_buffer_, records.data(), records.size());
+    append_bytes(corpus.owned_buffer_, ram_entries.data(), ram_entries.size());
+    append_bytes(corpus.owned_buffer_, cycle_entries.data(), cycle_entries.size());
+    append_bytes(corpus.owned_buffer_, names.data(), names.size());
+    corpus.data_ = corpus.owned_buffer_.data();
+    corpus.data_size_ = corpus.owned_buffer_.size();
+    corpus.bindSections();
+    return corpus;
+}
+
+TestCorpus TestCorpus::fromFile(const std::string& file_path) {
+    const int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        throw std::runtime_error("Unable to open test corpus " + file_path);
+    }
+
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(file_descriptor);
+        throw std::runtime_error("Test corpus " + file_path + " is truncated");
+    }
+
+    void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Unable to map test corpus " + file_path);
+    }
+
+    TestCorpus corpus;
+    corpus.data_ = static_cast<const uint8_t*>(mapping);
+    corpus.data_size_ = file_stat.st_size;
+    corpus.memory_mapped_ = true;
+    corpus.bindSections();
+    return corpus;
+}
+
+bool TestCorpus::isCorpusFile(const std::string& file_path) {
+    std::ifstream file_in(file_path, std::ios::binary);
+    char magic[sizeof(Header::magic)] = {};
+    file_in.read(magic, sizeof(magic));
+    return file_in && std::memcmp(magic, TEST_CORPUS_MAGIC, sizeof(magic)) == 0;
+}
+
+TestCorpus::TestCorpus(TestCorpus&& other) noexcept {
+    *this = std::move(other);
+}
+
+TestCorpus& TestCorpus::operator=(TestCorpus&& other) noexcept {
+    if (this == &other) return *this;
+    if (memory_mapped_) {
+        munmap(const_cast<uint8_t*>(data_), data_size_);
+    }
+    // Moving a vector keeps its heap block, so section pointers stay valid
+    owned_buffer_ = std::move(other.owned_buffer_);
+    data_ = std::exchange(other.data_, nullptr);
+    data_size_ = std::exchange(other.data_size_, 0);
+    memory_mapped_ = std::exchange(other.memory_mapped_, false);
+    header_ = std::exchange(other.header_, nullptr);
+    records_ = std::exchange(other.records_, nullptr);
+    ram_entries_ = std::exchange(other.ram_entries_, nullptr);
+    cycle_entries_ = std::exchange(other.cycle_entries_, nullptr);
+    names_ = std::exchange(other.names_, nullptr);
+    return *this;
+}
+
+TestCorpus::~TestCorpus() {
+    if (memory_mapped_) {
+        munmap(const_cast<uint8_t*>(data_), data_size_);
+    }
+}
+
+void TestCorpus::writeToFile(const std::string& file_path) const {
+    std::ofstream file_out(file_path, std::ios::binary | std::ios::trunc);
+    file_out.write(reinterpret_cast<const char*>(data_), data_size_);
+    if (!file_out) {
+        throw std::runtime_error("Unable to write test corpus " + file_path);
+    }
+}
+
+uint32_t TestCorpus::size() const {
+    return header_->test_count;
+}
+
+const TestCorpus::TestRecord& TestCorpus::record(const uint32_t& index) const {
+    return records_[index];
+}
+
+std::string_view TestCorpus::name(const uint32_t& index) const {
+    return std::string_view(names_ + records_[index].name_offset, records_[index].name_length);
+}
+
+std::span<const TestCorpus::RAMEntry> TestCorpus::initialRAM(const uint32_t& index) const {
+    return std::span<const RAMEntry>(ram_entries_ + records_[index].initial_ram_offset, records_[index].initial_ram_count);
+}
+
+std::span<const TestCorpus::RAMEntry> TestCorpus::finalRAM(const uint32_t& index) const {
+    return std::span<const RAMEntry>(ram_entries_ + records_[index].final_ram_offset, records_[index].final_ram_count);
+}
+
+std::span<const TestCorpus::CycleEntry> TestCorpus::cycles(const uint32_t& index) const {
+    return std::span<const CycleEntry>(cycle_entries_ + records_[index].cycles_offset, records_[index].cycles_count);
+}
+
+void TestCorpus::bindSections() {
+    if (data_size_ < sizeof(Header)) {
+        throw std::runtime_error("Test corpus is truncated");
+    }
+    header_ = reinterpret_cast<const Header*>(data_);
+    if (std::memcmp(header_->magic, TEST_CORPUS_MAGIC, sizeof(header_->magic)) != 0 || header_->version != TEST_CORPUS_VERSION) {
+        throw std::runtime_error("Unsupported test corpus format");
+    }
+
+    // The counts come from the file, so every step is checked for overflow before it is trusted
+    const size_t records_offset = sizeof(Header);
+    size_t ram_offset = records_offset;
+    bool sizes_valid = advance_section(ram_offset, header_->test_count, sizeof(TestRecord));
+    size_t cycles_offset = ram_offset;
+    sizes_valid = sizes_valid && advance_section(cycles_offset, header_->ram_entry_count, sizeof(RAMEntry));
+    size_t names_offset = cycles_offset;
+    sizes_valid = sizes_valid && advance_section(names_offset, header_->cycle_entry_count, sizeof(CycleEntry));
+    size_t end_offset = names_offset;
+    sizes_valid = sizes_valid && advance_section(end_offset, header_->name_bytes, 1);
+    if (!sizes_valid || end_offset != data_size_) {
+        throw std::runtime_error("Test corpus size does not match its header");
+    }
+
+    records_ = reinterpret_cast<const TestRecord*>(data_ + records_offset);
+    ram_entries_ = reinterpret_cast<const RAMEntry*>(data_ + ram_offset);
+    cycle_entries_ = reinterpret_cast<const CycleEntry*>(data_ + cycles_offset);
+    names_ = reinterpret_cast<const char*>(data_ + names_offset);
+
+    // Validated once here so the accessors can index the sections without checks
+    for (uint32_t index = 0; index < header_->test_count; index++) {
+        const TestRecord& test_record = records_[index];
+        if (!range_in_section(test_record.name_offset, test_record.name_length, header_->name_bytes) ||
+            !range_in_section(test_record.initial_ram_offset, test_record.initial_ram_count, header_->ram_entry_count) ||
+            !range_in_section(test_record.final_ram_offset, test_record.final_ram_count, header_->ram_entry_count) ||
+            !range_in_section(test_record.cycles_offset, test_record.cycles_count, header_->cycle_entry_count)) {
+            throw std::runtime_error("Test corpus record " + std::to_string(index) + " points outside its sections");
+        }
+    }
+}
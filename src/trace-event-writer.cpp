@@ -0,0 +1,131 @@
+#include "trace-event-writer.hpp"
+// Standard Library Includes
+#include <iomanip>
+#include <sstream>
+// Project Includes
+#include "mos6502.hpp"
+
+#define TRACE_PROCESS_ID 1
+#define TRACE_CPU_THREAD_ID 1
+#define TRACE_DEVICE_THREAD_ID 2
+#define TRACE_DMA_THREAD_ID 3
+
+static std::string timestamp(const uint64_t& cycle) {
+    // Trace timestamps are microseconds, MOS6502_CLOCK_PERIOD is nanoseconds per cycle
+    std::ostringstream time;
+    time << std::fixed << std::setprecision(3) << cycle * MOS6502_CLOCK_PERIOD / 1000.0;
+    return time.str();
+}
+
+static std::string hex_value(const uint16_t& value, const int& digits) {
+    std::ostringstream hex;
+    hex << "$" << std::hex << std::uppercase << std::setfill('0') << std::setw(digits) << value;
+    return hex.str();
+}
+
+static std::string json_string(const std::string& text) {
+    std::string quoted = "\"";
+    for (const char& character : text) {
+        if (character == '"' || character == '\\') quoted += '\\';
+        quoted += character;
+    }
+    return quoted + "\"";
+}
+
+static std::string thread_name_event(const int& thread_id, const std::string& name) {
+    return "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " + std::to_string(TRACE_PROCESS_ID) + ", \"tid\": " + std::to_string(thread_id) +
+        ", \"args\": {\"name\": " + json_string(name) + "}}";
+}
+
+TraceEventWriter::TraceEventWriter(std::ostream& out, const MOS6502& cpu, const SymbolTable& symbols):
+    out_{out}, symbols_{symbols}, cycle_{cpu.getCyclesElapsed()}, span_cycle_{cycle_}, devices_{}, shadow_call_stack_{*this}, first_event_{true}, finished_{false} {
+    out_ << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    writeEvent("{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " + std::to_string(TRACE_PROCESS_ID) + ", \"args\": {\"name\": \"MOS6502\"}}");
+    writeEvent(thread_name_event(TRACE_CPU_THREAD_ID, "CPU"));
+    writeEvent(thread_name_event(TRACE_DEVICE_THREAD_ID, "Devices"));
+    writeEvent(thread_name_event(TRACE_DMA_THREAD_ID, "DMA"));
+}
+
+void TraceEventWriter::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    // Calls begin when the JSR or BRK started, returns end when the instruction finished
+    span_cycle_ = cycle_;
+    cycle_ += cycles;
+    shadow_call_stack_.onInstruction(cpu, opcode);
+}
+
+void TraceEventWriter::onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {
+    span_cycle_ = cycle_;
+    shadow_call_stack_.onInterrupt(cpu, interrupt);
+}
+
+void TraceEventWriter::onRead(const uint16_t& address, const uint8_t& data) {
+    if (!devices_.empty()) traceDeviceAccess("read", address, data);
+}
+
+void TraceEventWriter::onWrite(const uint16_t& address, const uint8_t& data) {
+    if (!devices_.empty()) traceDeviceAccess("write", address, data);
+}
+
+void TraceEventWriter::addDevice(const std::string& name, const uint16_t& start, const uint16_t& end) {
+    devices_.push_back(Device{name, start, end});
+}
+
+void TraceEventWriter::onDMA(const std::string& name, const uint16_t& source, const uint16_t& destination, const uint32_t& length, const uint64_t& cycles) {
+    writeEvent("{\"name\": " + json_string(name) + ", \"cat\": \"dma\", \"ph\": \"X\", \"ts\": " + timestamp(cycle_) +
+        ", \"dur\": " + timestamp(cycles) + ", \"pid\": " + std::to_string(TRACE_PROCESS_ID) + ", \"tid\": " + std::to_string(TRACE_DMA_THREAD_ID) +
+        ", \"args\": {\"source\": " + json_string(hex_value(source, 4)) + ", \"destination\": " + json_string(hex_value(destination, 4)) + ", \"length\": " + std::to_string(length) + "}}");
+}
+
+void TraceEventWriter::finish() {
+    if (finished_) return;
+    shadow_call_stack_.unwind();
+    out_ << "\n]}" << std::endl;
+    finished_ = true;
+}
+
+void TraceEventWriter::writeEvent(const std::string& event) {
+    if (finished_) return;
+    out_ << (first_event_ ? "\n" : ",\n") << event;
+    first_event_ = false;
+}
+
+void TraceEventWriter::onCall(const ShadowCallStack::Frame& frame) {
+    beginSpan(frame, span_cycle_);
+}
+
+void TraceEventWriter::onReturn(const ShadowCallStack::Frame& frame) {
+    endSpan();
+}
+
+void TraceEventWriter::onTailCall(const ShadowCallStack::Frame& previous, const ShadowCallStack::Frame& frame) {
+    endSpan();
+    beginSpan(frame, cycle_);
+}
+
+void TraceEventWriter::beginSpan(const ShadowCallStack::Frame& frame, const uint64_t& cycle) {
+    std::string name = symbols_.name(frame.function);
+    switch (frame.type) {
+        case ShadowCallStack::FrameType::BRK: name = "BRK"; break;
+        case ShadowCallStack::FrameType::IRQ: name = "IRQ"; break;
+        case ShadowCallStack::FrameType::NMI: name = "NMI"; break;
+        default: break;
+    }
+    const std::string category = frame.type == ShadowCallStack::FrameType::SUBROUTINE ? "subroutine" : "interrupt";
+    writeEvent("{\"name\": " + json_string(name) + ", \"cat\": \"" + category + "\", \"ph\": \"B\", \"ts\": " + timestamp(cycle) +
+        ", \"pid\": " + std::to_string(TRACE_PROCESS_ID) + ", \"tid\": " + std::to_string(TRACE_CPU_THREAD_ID) + "}");
+}
+
+void TraceEventWriter::endSpan() {
+    // End events close the innermost open span of the track, so they need no name
+    writeEvent("{\"ph\": \"E\", \"ts\": " + timestamp(cycle_) + ", \"pid\": " + std::to_string(TRACE_PROCESS_ID) + ", \"tid\": " + std::to_string(TRACE_CPU_THREAD_ID) + "}");
+}
+
+void TraceEventWriter::traceDeviceAccess(const std::string& access, const uint16_t& address, const uint8_t& data) {
+    for (const Device& device : devices_) {
+        if (address < device.start || address > device.end) continue;
+        writeEvent("{\"name\": " + json_string(device.name + " " + access + " " + hex_value(address, 4)) +
+            ", \"cat\": \"device\", \"ph\": \"i\", \"s\": \"t\", \"ts\": " + timestamp(cycle_) + ", \"pid\": " + std::to_string(TRACE_PROCESS_ID) +
+            ", \"tid\": " + std::to_string(TRACE_DEVICE_THREAD_ID) + ", \"args\": {\"data\": " + json_string(hex_value(data, 2)) + "}}");
+        return;
+    }
+}
@@ -0,0 +1,63 @@
+#include "uninitialized-read-detector.hpp"
+// Standard Library Includes
+#include <algorithm>
+#include <iomanip>
+// Project Includes
+#include "mos6502.hpp"
+
+#define SHADOW_MEMORY_ADDRESSES 65536
+
+UninitializedReadDetector::UninitializedReadDetector(const MOS6502& cpu):
+    initialized_(SHADOW_MEMORY_ADDRESSES), instruction_address_{cpu.getState().program_counter},
+    instruction_cycle_{cpu.getCyclesElapsed()}, uninitialized_reads_{} {}
+
+void UninitializedReadDetector::onRead(const uint16_t& address, const uint8_t& data) {
+    if (initialized_[address]) [[likely]] return;
+    UninitializedRead& uninitialized_read = uninitialized_reads_.try_emplace(
+        {instruction_address_, address}, UninitializedRead{instruction_address_, address, instruction_cycle_, 0}).first->second;
+    uninitialized_read.count++;
+}
+
+void UninitializedReadDetector::onWrite(const uint16_t& address, const uint8_t& data) {
+    initialized_[address] = true;
+}
+
+void UninitializedReadDetector::onInstruction(const MOS6502& cpu, const uint16_t& address, const uint8_t& opcode, const uint8_t& cycles) {
+    instruction_address_ = cpu.getState().program_counter;
+    instruction_cycle_ += cycles;
+}
+
+void UninitializedReadDetector::onInterrupt(const MOS6502& cpu, const Interrupt& interrupt, const uint16_t& return_address) {
+    instruction_address_ = cpu.getState().program_counter;
+}
+
+void UninitializedReadDetector::markInitialized(const uint16_t& start_address, const uint32_t& size) {
+    for (uint32_t i = 0; i < size; i++) {
+        initialized_[static_cast<uint16_t>(start_address + i)] = true;
+    }
+}
+
+std::vector<UninitializedReadDetector::UninitializedRead> UninitializedReadDetector::getUninitializedReads() const {
+    std::vector<UninitializedRead> reads;
+    for (const auto& [key, uninitialized_read] : uninitialized_reads_) {
+        reads.push_back(uninitialized_read);
+    }
+    std::stable_sort(reads.begin(), reads.end(), [](const UninitializedRead& a, const UninitializedRead& b) {
+        return a.first_cycle < b.first_cycle;
+    });
+    return reads;
+}
+
+void UninitializedReadDetector::writeReport(std::ostream& out) const {
+    const std::vector<UninitializedRead> reads = getUninitializedReads();
+    if (reads.empty()) {
+        out << "No reads of uninitialized memory\n";
+        return;
+    }
+    out << std::left << std::setw(14) << "Instruction" << std::setw(10) << "Address" << std::right << std::setw(16) << "First cycle" << std::setw(10) << "Count" << "\n";
+    for (const UninitializedRead& read : reads) {
+        out << "$" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << read.instruction_address << "         ";
+        out << "$" << std::setw(4) << read.address << std::dec << std::nouppercase << std::setfill(' ') << "     ";
+        out << std::setw(16) << read.first_cycle << std::setw(10) << read.count << "\n";
+    }
+}
@@ -0,0 +1,65 @@
+// Compares two benchmark --json result files and fails on significant regressions
+//   Usage: bench-compare <baseline.json> <candidate.json> [--threshold <percent>] [--alpha <significance>]
+//   Exits with code 1 if a workload is slower by more than the threshold (default 5%) with p < alpha (default 0.05)
+// Standard Library Headers
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+// Project Headers
+#include "benchmark-comparison.hpp"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <baseline.json> <candidate.json> [--threshold <percent>] [--alpha <significance>]" << std::endl;
+}
+
+static json load_results(const std::string& file_path) {
+    std::ifstream file_in(file_path);
+    if (!file_in) {
+        throw std::runtime_error("Unable to open " + file_path);
+    }
+    return json::parse(file_in);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    double threshold_percent = 5;
+    double alpha = 0.05;
+    for (int arg_index = 3; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        if (arg_index + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        // std::stod throws on malformed numbers
+        try {
+            if (arg == "--threshold") {
+                threshold_percent = std::stod(argv[++arg_index]);
+            }
+            else if (arg == "--alpha") {
+                alpha = std::stod(argv[++arg_index]);
+            }
+            else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+        catch (const std::logic_error&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        const BenchmarkComparison comparison{load_results(argv[1]), load_results(argv[2]), threshold_percent, alpha};
+        comparison.writeReport(std::cout);
+        return comparison.hasRegression() ? 1 : 0;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,200 @@
+// Times the bundled synthetic workloads and reports emulated speed, the cost of every instruction with --micro,
+//   or the latency of creating a machine and running its first instruction with --startup
+//   --scaling runs every workload on 1 to --threads threads with --instances instances each and reports aggregate throughput
+//   Usage: benchmark [--micro | --startup | --scaling] [--threads <count>] [--instances <per thread>] [--layout private-ram|shared-rom|both] [--instructions <count>] [--warmup <repetitions>] [--repetitions <count>] [--counters] [--json <file>] [--list] [workload...]
+//   --counters also reads host performance counters around every timed repetition and reports them per emulated instruction
+//   A workload argument selects every workload whose name, or any word of its name, matches it (e.g. "sort", "ABX", "LDA", "a9")
+// Standard Library Headers
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+// Project Headers
+#include "benchmark-runner.hpp"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--micro | --startup | --scaling] [--threads <count>] [--instances <per thread>] [--layout private-ram|shared-rom|both] [--instructions <count>] [--warmup <repetitions>] [--repetitions <count>] [--counters] [--json <file>] [--list] [workload...]" << std::endl;
+}
+
+static bool workload_selected(const BenchmarkWorkload& workload, const std::vector<std::string>& selected_workloads) {
+    if (selected_workloads.empty()) return true;
+    std::stringstream name(workload.name);
+    std::vector<std::string> name_words{workload.name};
+    for (std::string word; name >> word;) {
+        name_words.push_back(word);
+    }
+    return std::find_first_of(name_words.begin(), name_words.end(), selected_workloads.begin(), selected_workloads.end()) != name_words.end();
+}
+
+// Writes the results if a path was given
+static bool write_json(const std::string& json_path, const json& results) {
+    if (json_path.empty()) return true;
+    std::ofstream json_out(json_path, std::ios::trunc);
+    json_out << results.dump(2) << std::endl;
+    if (!json_out) {
+        std::cerr << "Unable to write " << json_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOptions options;
+    std::optional<uint64_t> instructions;
+    std::optional<uint32_t> repetitions;
+    bool micro = false;
+    bool startup = false;
+    bool scaling = false;
+    uint32_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t instances_per_thread = 1;
+    std::vector<MemoryLayout> layouts{MemoryLayout::PRIVATE_RAM, MemoryLayout::SHARED_ROM};
+    bool list = false;
+    std::string json_path;
+    std::vector<std::string> selected_workloads;
+    for (int arg_index = 1; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        // std::stoul and std::stoull throw on malformed numbers
+        try {
+            if (arg == "--list") {
+                list = true;
+            }
+            else if (arg == "--micro") {
+                micro = true;
+            }
+            else if (arg == "--startup") {
+                startup = true;
+            }
+            else if (arg == "--scaling") {
+                scaling = true;
+            }
+            else if (arg == "--counters") {
+                options.hardware_counters = true;
+            }
+            else if (arg == "--startup-child") {
+                // Spawned by --startup, the process only creates a machine and runs one instruction
+                BenchmarkRunner::startMachine(buildWorkloadImage(syntheticWorkloads().front()));
+                return 0;
+            }
+            else if (arg.starts_with("--") && arg_index + 1 >= argc) {
+                print_usage(argv[0]);
+                return 2;
+            }
+            else if (arg == "--instructions") {
+                instructions = std::max(1ull, std::stoull(argv[++arg_index]));
+            }
+            else if (arg == "--warmup") {
+                options.warmup_repetitions = std::stoul(argv[++arg_index]);
+            }
+            else if (arg == "--threads") {
+                max_threads = std::max(1ul, std::stoul(argv[++arg_index]));
+            }
+            else if (arg == "--instances") {
+                instances_per_thread = std::max(1ul, std::stoul(argv[++arg_index]));
+            }
+            else if (arg == "--layout") {
+                const std::string layout = argv[++arg_index];
+                if (layout == "private-ram") {
+                    layouts = {MemoryLayout::PRIVATE_RAM};
+                }
+                else if (layout == "shared-rom") {
+                    layouts = {MemoryLayout::SHARED_ROM};
+                }
+                else if (layout != "both") {
+                    print_usage(argv[0]);
+                    return 2;
+                }
+            }
+            else if (arg == "--json") {
+                json_path = argv[++arg_index];
+            }
+            else if (arg == "--repetitions") {
+                repetitions = std::max(1ul, std::stoul(argv[++arg_index]));
+            }
+            else if (arg.starts_with("--")) {
+                print_usage(argv[0]);
+                return 2;
+            }
+            else {
+                selected_workloads.push_back(arg);
+            }
+        }
+        catch (const std::logic_error&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Every microbenchmark instruction is short, so fewer are needed for a stable median
+    //   Scaling runs the count on every instance, so it uses fewer per instance
+    options.instructions = instructions.value_or(micro ? 200000 : scaling ? 1000000 : options.instructions);
+    // Startup samples are single machine creations, so many more are needed for stable percentiles
+    options.repetitions = repetitions.value_or(startup ? 1000 : options.repetitions);
+
+    if (startup) {
+        const BenchmarkRunner benchmark_runner{options};
+        std::vector<BenchmarkResult> results;
+        try {
+            results.push_back(benchmark_runner.measureStartup(buildWorkloadImage(syntheticWorkloads().front())));
+            results.push_back(benchmark_runner.measureProcessStartup("/proc/self/exe", {"--startup-child"}));
+        }
+        catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+        BenchmarkRunner::writeLatencyReport(std::cout, results);
+        return write_json(json_path, benchmark_runner.toJSON("startup", results)) ? 0 : 2;
+    }
+
+    const std::vector<BenchmarkWorkload> all_workloads = micro ? microbenchmarkWorkloads() : syntheticWorkloads();
+    std::vector<const BenchmarkWorkload*> workloads;
+    for (const BenchmarkWorkload& workload : all_workloads) {
+        if (workload_selected(workload, selected_workloads)) {
+            workloads.push_back(&workload);
+        }
+    }
+    if (list) {
+        for (const BenchmarkWorkload* workload : workloads) {
+            std::cout << workload->name << (workload->description.empty() ? "" : ": " + workload->description) << std::endl;
+        }
+        return 0;
+    }
+    if (workloads.empty()) {
+        std::cerr << "No workload matches, see --list" << std::endl;
+        return 2;
+    }
+
+    const BenchmarkRunner benchmark_runner{options};
+    std::vector<BenchmarkResult> results;
+    if (scaling) {
+        for (const BenchmarkWorkload* workload : workloads) {
+            for (const MemoryLayout& layout : layouts) {
+                for (uint32_t threads = 1; threads <= max_threads; threads++) {
+                    results.push_back(benchmark_runner.runScaling(*workload, threads, instances_per_thread, layout));
+                }
+            }
+        }
+        std::cout << options.instructions << " instructions per instance x " << options.repetitions << " repetitions (" << options.warmup_repetitions << " warmup), median times" << std::endl;
+        BenchmarkRunner::writeScalingReport(std::cout, results);
+        return write_json(json_path, benchmark_runner.toJSON("scaling", results)) ? 0 : 2;
+    }
+    for (const BenchmarkWorkload* workload : workloads) {
+        results.push_back(benchmark_runner.run(*workload));
+    }
+    std::cout << options.instructions << " instructions x " << options.repetitions << " repetitions (" << options.warmup_repetitions << " warmup), median times" << std::endl;
+    if (micro) {
+        BenchmarkRunner::writeCostReport(std::cout, results);
+    }
+    else {
+        BenchmarkRunner::writeReport(std::cout, results);
+    }
+    if (options.hardware_counters) {
+        std::cout << std::endl;
+        BenchmarkRunner::writeCounterReport(std::cout, results);
+    }
+    return write_json(json_path, benchmark_runner.toJSON(micro ? "micro" : "synthetic", results)) ? 0 : 2;
+}
@@ -0,0 +1,67 @@
+// Differentially fuzzes two execution engines with random states, memory and opcode streams
+//   Usage: fuzz [--seed <seed>] [--cases <count>] [--instructions <count>] [--jobs <threads>] [--engines <reference>,<candidate>] [--max-mismatches <count>] [--out <directory>]
+//   Exits with code 1 if the engines disagreed, the minimized cases are written as SingleStepTests files
+// Standard Library Headers
+#include <iostream>
+#include <string>
+#include <stdexcept>
+// Project Headers
+#include "differential-fuzzer.hpp"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--seed <seed>] [--cases <count>] [--instructions <count>] [--jobs <threads>] [--engines <reference>,<candidate>] [--max-mismatches <count>] [--out <directory>]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    FuzzOptions options;
+    for (int arg_index = 1; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        if (arg_index + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        const std::string value = argv[++arg_index];
+        // std::stoul and std::stoull throw on malformed numbers
+        try {
+            if (arg == "--seed") {
+                options.seed = std::stoull(value, nullptr, 0);
+            }
+            else if (arg == "--cases") {
+                options.cases = std::stoull(value);
+            }
+            else if (arg == "--instructions") {
+                options.instructions_per_case = std::max(1ul, std::stoul(value));
+            }
+            else if (arg == "--jobs") {
+                options.jobs = std::stoul(value);
+            }
+            else if (arg == "--engines" && value.find(',') != std::string::npos) {
+                options.reference_engine = value.substr(0, value.find(','));
+                options.candidate_engine = value.substr(value.find(',') + 1);
+            }
+            else if (arg == "--max-mismatches") {
+                options.max_mismatches = std::max(1ull, std::stoull(value));
+            }
+            else if (arg == "--out") {
+                options.output_directory = value;
+            }
+            else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+        catch (const std::logic_error&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        DifferentialFuzzer fuzzer{options};
+        return fuzzer.run(std::cout).empty() ? 0 : 1;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,42 @@
+// Converts SingleStepTests JSON files into the binary test corpus format
+//   Usage: json-to-corpus <json-file-or-directory> <output-file-or-directory>
+//   A directory input converts every "XX.json" file into "XX.bin" in the output directory
+// Standard Library Headers
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+// Project Headers
+#include "test-corpus.hpp"
+
+static void convert_file(const std::filesystem::path& json_path, const std::filesystem::path& corpus_path) {
+    std::ifstream json_file(json_path);
+    const TestCorpus corpus = TestCorpus::fromJSON(json::parse(json_file));
+    corpus.writeToFile(corpus_path);
+    std::cout << json_path.string() << " -> " << corpus_path.string() << " (" << corpus.size() << " tests)" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <json-file-or-directory> <output-file-or-directory>" << std::endl;
+        return 1;
+    }
+    const std::filesystem::path input_path = argv[1];
+    const std::filesystem::path output_path = argv[2];
+
+    try {
+        if (!std::filesystem::is_directory(input_path)) {
+            convert_file(input_path, output_path);
+            return 0;
+        }
+        std::filesystem::create_directories(output_path);
+        for (const auto& entry : std::filesystem::directory_iterator(input_path)) {
+            if (entry.path().extension() != ".json") continue;
+            convert_file(entry.path(), output_path / entry.path().filename().replace_extension(".bin"));
+        }
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Runs a program on two execution engines in lockstep and reports the first divergence
+//   Usage: lockstep <image> [--load <address>] [--start <pc>] [--instructions <count>] [--every <count>] [--engines <reference>,<candidate>]
+//   The image is copied into a 64kB RAM at the load address, execution starts at the reset vector unless --start is given
+// Standard Library Headers
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// Project Headers
+#include "lockstep-runner.hpp"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <image> [--load <address>] [--start <pc>] [--instructions <count>] [--every <count>] [--engines <reference>,<candidate>]" << std::endl;
+    std::cerr << "Engines:";
+    for (const ExecutionEngine& engine : execution_engines) {
+        std::cerr << " " << engine.name;
+    }
+    std::cerr << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    const std::string image_path = argv[1];
+    uint16_t load_address = 0x0000;
+    std::optional<uint16_t> start_pc;
+    uint64_t max_instructions = 1000000;
+    uint64_t compare_interval = 1;
+    std::string reference_name = std::string(execution_engines[0].name);
+    std::string candidate_name = std::string(execution_engines[1].name);
+
+    for (int arg_index = 2; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        if (arg_index + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        const std::string value = argv[++arg_index];
+        // std::stoul and std::stoull throw on malformed numbers
+        try {
+            if (arg == "--load") {
+                load_address = std::stoul(value, nullptr, 0);
+            }
+            else if (arg == "--start") {
+                start_pc = std::stoul(value, nullptr, 0);
+            }
+            else if (arg == "--instructions") {
+                max_instructions = std::stoull(value);
+            }
+            else if (arg == "--every") {
+                compare_interval = std::max<uint64_t>(1, std::stoull(value));
+            }
+            else if (arg == "--engines" && value.find(',') != std::string::npos) {
+                reference_name = value.substr(0, value.find(','));
+                candidate_name = value.substr(value.find(',') + 1);
+            }
+            else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+        catch (const std::logic_error&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const ExecutionEngine* reference = findExecutionEngine(reference_name);
+    const ExecutionEngine* candidate = findExecutionEngine(candidate_name);
+    if (reference == nullptr || candidate == nullptr) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::ifstream image_file(image_path, std::ios::binary);
+    if (!image_file) {
+        std::cerr << "Unable to open " << image_path << std::endl;
+        return 2;
+    }
+    const std::vector<uint8_t> image_bytes((std::istreambuf_iterator<char>(image_file)), std::istreambuf_iterator<char>());
+    MemoryUnit image(65536);
+    for (size_t i = 0; i < image_bytes.size() && load_address + i < 65536; i++) {
+        image.write(load_address + i, image_bytes[i]);
+    }
+
+    std::optional<MOS6502::State> initial_state;
+    if (start_pc.has_value()) {
+        initial_state = MOS6502::State{*start_pc, 0xFD, 0, 0, 0, 0b00110110};
+    }
+
+    LockstepRunner lockstep_runner{image, *reference, *candidate, initial_state};
+    const std::optional<LockstepRunner::Divergence> divergence = lockstep_runner.run(max_instructions, compare_interval);
+    if (divergence.has_value()) {
+        lockstep_runner.writeDivergence(std::cout, *divergence);
+        return 1;
+    }
+    std::cout << reference->name << " and " << candidate->name << " agreed for " << lockstep_runner.getInstructionsExecuted() << " instructions" << std::endl;
+    return 0;
+}
@@ -0,0 +1,377 @@
+// Runs a program and reports where its emulated cycles are spent
+//   Usage: profile <image> [--load <address>] [--start <pc>] [--instructions <count>] [--sample <cycles>] [--top <count>]
+//                  [--symbols <file>]... [--callgraph <folded file>] [--heatmap <file.ppm|.pgm|.csv>] [--heatmap-access reads|writes|executes|all]
+//                  [--cdl <file>] [--source-map <ca65 debug file> --lcov <file>] [--uninitialized image|<start>-<end>[,...]]
+//                  [--stack] [--isa-coverage <file.json>] [--trace <file.json>] [--trace-device <name>:<start>-<end>]...
+//   The image is copied into a 64kB RAM at the load address, execution starts at the reset vector unless --start is given
+//   --sample records only the instruction running every <cycles> cycles instead of counting every instruction
+//   --callgraph also attributes cycles to emulated subroutines and writes their call paths in folded-stack format
+//   --symbols loads function names from a ca65 debug file or a VICE label file
+//   --heatmap counts every read, write and executed opcode per address and saves a 256x256 map, one row per page
+//   --cdl logs which addresses were used as opcodes, operands and data, merged into the file if it exists,
+//   and --lcov turns the log into line coverage of the sources in --source-map
+//   --uninitialized reports reads of memory never written since reset; bytes loaded from the image count as written
+//   unless they fall in one of the given RAM ranges
+//   --stack reports the worst-case stack depth, stack pointer wraparounds and the stack each subroutine needed
+//   --isa-coverage reports which opcodes, page crossings, branch outcomes and ADC/SBC/compare flag results were exercised
+//   --trace writes subroutine and interrupt spans and accesses to the --trace-device register ranges as Chrome trace events
+// Standard Library Headers
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <optional>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+// Project Headers
+#include "bus.hpp"
+#include "mos6502.hpp"
+#include "memory-unit.hpp"
+#include "pc-profiler.hpp"
+#include "symbol-table.hpp"
+#include "call-graph-profiler.hpp"
+#include "memory-heatmap.hpp"
+#include "source-map.hpp"
+#include "code-data-logger.hpp"
+#include "uninitialized-read-detector.hpp"
+#include "stack-analyzer.hpp"
+#include "isa-coverage.hpp"
+#include "trace-event-writer.hpp"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <image> [--load <address>] [--start <pc>] [--instructions <count>] [--sample <cycles>] [--top <count>]";
+    std::cerr << " [--symbols <file>]... [--callgraph <folded file>] [--heatmap <file.ppm|.pgm|.csv>] [--heatmap-access reads|writes|executes|all]";
+    std::cerr << " [--cdl <file>] [--source-map <ca65 debug file> --lcov <file>] [--uninitialized image|<start>-<end>[,...]] [--stack] [--isa-coverage <file.json>]";
+    std::cerr << " [--trace <file.json>] [--trace-device <name>:<start>-<end>]..." << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    const std::string image_path = argv[1];
+    uint16_t load_address = 0x0000;
+    std::optional<uint16_t> start_pc;
+    uint64_t max_instructions = 1000000;
+    uint64_t sample_interval = 0;
+    size_t top = 20;
+    SymbolTable symbols;
+    std::string callgraph_path;
+    std::string heatmap_path;
+    MemoryHeatmap::Access heatmap_access = MemoryHeatmap::Access::ALL;
+    std::string cdl_path;
+    std::string lcov_path;
+    SourceMap source_map;
+    bool detect_uninitialized = false;
+    // RAM ranges whose image bytes do not count as written
+    std::vector<std::pair<uint16_t, uint16_t>> ram_ranges;
+    bool analyze_stack = false;
+    std::string isa_coverage_path;
+    std::string trace_path;
+    struct TraceDevice {
+        std::string name;
+        uint16_t start;
+        uint16_t end;
+    };
+    std::vector<TraceDevice> trace_devices;
+
+    for (int arg_index = 2; arg_index < argc; arg_index++) {
+        const std::string arg = argv[arg_index];
+        if (arg == "--stack") {
+            analyze_stack = true;
+            continue;
+        }
+        if (arg_index + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        const std::string value = argv[++arg_index];
+        // std::stoul and std::stoull throw on malformed numbers
+        try {
+            if (arg == "--load") {
+                load_address = std::stoul(value, nullptr, 0);
+            }
+            else if (arg == "--start") {
+                start_pc = std::stoul(value, nullptr, 0);
+            }
+            else if (arg == "--instructions") {
+                max_instructions = std::stoull(value);
+            }
+            else if (arg == "--sample") {
+                sample_interval = std::stoull(value);
+            }
+            else if (arg == "--top") {
+                top = std::stoul(value);
+            }
+            else if (arg == "--symbols") {
+                try {
+                    symbols.loadFile(value);
+                }
+                catch (const std::exception& error) {
+                    std::cerr << error.what() << std::endl;
+                    return 2;
+                }
+            }
+            else if (arg == "--callgraph") {
+                callgraph_path = value;
+            }
+            else if (arg == "--heatmap" && (value.ends_with(".ppm") || value.ends_with(".pgm") || value.ends_with(".csv"))) {
+                heatmap_path = value;
+            }
+            else if (arg == "--heatmap-access" && value == "reads") {
+                heatmap_access = MemoryHeatmap::Access::READ;
+            }
+            else if (arg == "--heatmap-access" && value == "writes") {
+                heatmap_access = MemoryHeatmap::Access::WRITE;
+            }
+            else if (arg == "--heatmap-access" && value == "executes") {
+                heatmap_access = MemoryHeatmap::Access::EXECUTE;
+            }
+            else if (arg == "--heatmap-access" && value == "all") {
+                heatmap_access = MemoryHeatmap::Access::ALL;
+            }
+            else if (arg == "--cdl") {
+                cdl_path = value;
+            }
+            else if (arg == "--lcov") {
+                lcov_path = value;
+            }
+            else if (arg == "--uninitialized") {
+                detect_uninitialized = true;
+                std::stringstream ranges(value == "image" ? "" : value);
+                for (std::string range; std::getline(ranges, range, ',');) {
+                    if (range.find('-') == std::string::npos) {
+                        print_usage(argv[0]);
+                        return 2;
+                    }
+                    ram_ranges.emplace_back(std::stoul(range.substr(0, range.find('-')), nullptr, 0), std::stoul(range.substr(range.find('-') + 1), nullptr, 0));
+                }
+            }
+            else if (arg == "--isa-coverage") {
+                isa_coverage_path = value;
+            }
+            else if (arg == "--trace") {
+                trace_path = value;
+            }
+            else if (arg == "--trace-device") {
+                const size_t colon = value.rfind(':');
+                const size_t dash = value.find('-', colon);
+                if (colon == std::string::npos || dash == std::string::npos) {
+                    print_usage(argv[0]);
+                    return 2;
+                }
+                trace_devices.push_back(TraceDevice{value.substr(0, colon), static_cast<uint16_t>(std::stoul(value.substr(colon + 1, dash - colon - 1), nullptr, 0)),
+                    static_cast<uint16_t>(std::stoul(value.substr(dash + 1), nullptr, 0))});
+            }
+            else if (arg == "--source-map") {
+                try {
+                    source_map.loadFile(value);
+                }
+                catch (const std::exception& error) {
+                    std::cerr << error.what() << std::endl;
+                    return 2;
+                }
+            }
+            else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+        catch (const std::logic_error&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::ifstream image_file(image_path, std::ios::binary);
+    if (!image_file) {
+        std::cerr << "Unable to open " << image_path << std::endl;
+        return 2;
+    }
+    const std::vector<uint8_t> image_bytes((std::istreambuf_iterator<char>(image_file)), std::istreambuf_iterator<char>());
+    MemoryUnit ram(65536);
+    for (size_t i = 0; i < image_bytes.size() && load_address + i < 65536; i++) {
+        ram.write(load_address + i, image_bytes[i]);
+    }
+
+    MOS6502 cpu;
+    BUS bus(cpu, ram);
+    if (start_pc.has_value()) {
+        cpu.setState(MOS6502::State{*start_pc, 0xFD, 0, 0, 0, 0b00110110});
+    }
+
+    // Observers that need the CPU state at the start of the run are only built when asked for
+    std::optional<UninitializedReadDetector> uninitialized_read_detector;
+    if (detect_uninitialized) {
+        uninitialized_read_detector.emplace(cpu);
+        for (size_t i = 0; i < image_bytes.size() && load_address + i < 65536; i++) {
+            const uint16_t address = load_address + i;
+            const bool in_ram = std::any_of(ram_ranges.begin(), ram_ranges.end(), [&address](const std::pair<uint16_t, uint16_t>& range) {
+                return address >= range.first && address <= range.second;
+            });
+            if (!in_ram) uninitialized_read_detector->markInitialized(address, 1);
+        }
+    }
+    std::optional<StackAnalyzer> stack_analyzer;
+    if (analyze_stack) {
+        stack_analyzer.emplace(cpu, symbols);
+    }
+    std::optional<ISACoverage> isa_coverage;
+    if (!isa_coverage_path.empty()) {
+        isa_coverage.emplace(bus);
+    }
+    std::ofstream trace_out;
+    std::optional<TraceEventWriter> trace_event_writer;
+    if (!trace_path.empty()) {
+        trace_out.open(trace_path, std::ios::trunc);
+        if (!trace_out) {
+            std::cerr << "Unable to write " << trace_path << std::endl;
+            return 2;
+        }
+        trace_event_writer.emplace(trace_out, cpu, symbols);
+        for (const TraceDevice& device : trace_devices) {
+            trace_event_writer->addDevice(device.name, device.start, device.end);
+        }
+    }
+    PCProfiler pc_profiler{sample_interval};
+    CallGraphProfiler call_graph_profiler{symbols};
+    cpu.addObserver(&pc_profiler);
+    MemoryHeatmap memory_heatmap;
+    CodeDataLogger code_data_logger;
+    if (!cdl_path.empty() && std::ifstream(cdl_path)) {
+        try {
+            code_data_logger.mergeCDL(cdl_path);
+        }
+        catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+    }
+    if (!callgraph_path.empty()) {
+        cpu.addObserver(&call_graph_profiler);
+    }
+    if (!heatmap_path.empty()) {
+        cpu.addObserver(&memory_heatmap);
+        bus.addObserver(&memory_heatmap);
+    }
+    if (!cdl_path.empty() || !lcov_path.empty()) {
+        cpu.addObserver(&code_data_logger);
+        bus.addObserver(&code_data_logger);
+    }
+    if (uninitialized_read_detector) {
+        cpu.addObserver(&*uninitialized_read_detector);
+        bus.addObserver(&*uninitialized_read_detector);
+    }
+    if (stack_analyzer) {
+        cpu.addObserver(&*stack_analyzer);
+    }
+    if (isa_coverage) {
+        cpu.addObserver(&*isa_coverage);
+    }
+    if (trace_event_writer) {
+        cpu.addObserver(&*trace_event_writer);
+        bus.addObserver(&*trace_event_writer);
+    }
+    for (uint64_t i = 0; i < max_instructions; i++) {
+        cpu.runInstruction();
+    }
+    cpu.removeObserver(&pc_profiler);
+    cpu.removeObserver(&call_graph_profiler);
+    cpu.removeObserver(&memory_heatmap);
+    bus.removeObserver(&memory_heatmap);
+    cpu.removeObserver(&code_data_logger);
+    bus.removeObserver(&code_data_logger);
+    if (uninitialized_read_detector) {
+        cpu.removeObserver(&*uninitialized_read_detector);
+        bus.removeObserver(&*uninitialized_read_detector);
+    }
+    if (stack_analyzer) {
+        cpu.removeObserver(&*stack_analyzer);
+    }
+    if (isa_coverage) {
+        cpu.removeObserver(&*isa_coverage);
+    }
+    if (trace_event_writer) {
+        cpu.removeObserver(&*trace_event_writer);
+        bus.removeObserver(&*trace_event_writer);
+    }
+
+    std::cout << max_instructions << " instructions, " << cpu.getCyclesElapsed() << " cycles" << std::endl;
+    pc_profiler.writeReport(std::cout, ram, top);
+    if (!callgraph_path.empty()) {
+        std::cout << std::endl;
+        call_graph_profiler.writeReport(std::cout, top);
+        std::ofstream callgraph_out(callgraph_path, std::ios::trunc);
+        call_graph_profiler.writeFoldedStacks(callgraph_out);
+        if (!callgraph_out) {
+            std::cerr << "Unable to write " << callgraph_path << std::endl;
+            return 2;
+        }
+    }
+    if (!heatmap_path.empty()) {
+        std::cout << std::endl;
+        memory_heatmap.writeReport(std::cout, top);
+        std::ofstream heatmap_out(heatmap_path, std::ios::binary | std::ios::trunc);
+        if (heatmap_path.ends_with(".ppm")) {
+            memory_heatmap.writePPM(heatmap_out);
+        }
+        else if (heatmap_path.ends_with(".pgm")) {
+            memory_heatmap.writePGM(heatmap_out, heatmap_access);
+        }
+        else {
+            memory_heatmap.writeCSV(heatmap_out, heatmap_access);
+        }
+        if (!heatmap_out) {
+            std::cerr << "Unable to write " << heatmap_path << std::endl;
+            return 2;
+        }
+    }
+    if (!cdl_path.empty() || !lcov_path.empty()) {
+        std::cout << std::endl;
+        code_data_logger.writeReport(std::cout);
+        try {
+            if (!cdl_path.empty()) code_data_logger.writeCDL(cdl_path);
+        }
+        catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+    }
+    if (!lcov_path.empty()) {
+        std::ofstream lcov_out(lcov_path, std::ios::trunc);
+        code_data_logger.writeLcov(lcov_out, source_map);
+        if (!lcov_out) {
+            std::cerr << "Unable to write " << lcov_path << std::endl;
+            return 2;
+        }
+    }
+    if (uninitialized_read_detector) {
+        std::cout << std::endl;
+        uninitialized_read_detector->writeReport(std::cout);
+    }
+    if (stack_analyzer) {
+        std::cout << std::endl;
+        stack_analyzer->writeReport(std::cout, top);
+    }
+    if (isa_coverage) {
+        std::cout << std::endl;
+        isa_coverage->writeReport(std::cout, top);
+        std::ofstream isa_coverage_out(isa_coverage_path, std::ios::trunc);
+        isa_coverage->writeJSON(isa_coverage_out);
+        if (!isa_coverage_out) {
+            std::cerr << "Unable to write " << isa_coverage_path << std::endl;
+            return 2;
+        }
+    }
+    if (trace_event_writer) {
+        trace_event_writer->finish();
+        if (!trace_out) {
+            std::cerr << "Unable to write " << trace_path << std::endl;
+            return 2;
+        }
+    }
+    return 0;
+}